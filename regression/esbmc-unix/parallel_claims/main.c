@@ -0,0 +1,15 @@
+int nondet_int();
+
+int a[8];
+
+int main()
+{
+  int i = nondet_int();
+  int j = nondet_int();
+  __ESBMC_assume(i >= 0 && i < 8);
+  __ESBMC_assume(j >= 0 && j < 4);
+  a[i] = 1;
+  a[2 * j] = 2;
+  a[i + 1 < 8 ? i + 1 : 0] = 3;
+  return 0;
+}
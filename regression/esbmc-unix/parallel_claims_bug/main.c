@@ -0,0 +1,13 @@
+int nondet_int();
+
+int a[8];
+
+int main()
+{
+  int i = nondet_int();
+  __ESBMC_assume(i >= 0 && i < 8);
+  a[i] = 1;
+  __ESBMC_assert(i < 8, "index stays in range");
+  __ESBMC_assert(a[i] == 2, "value was stored");
+  return 0;
+}
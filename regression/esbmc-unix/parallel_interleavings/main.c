@@ -0,0 +1,24 @@
+#include <pthread.h>
+
+int g;
+pthread_mutex_t mutex;
+
+void *t1(void *arg)
+{
+  pthread_mutex_lock(&mutex);
+  g = g + 1;
+  pthread_mutex_unlock(&mutex);
+}
+
+int main()
+{
+  pthread_t id1, id2;
+
+  pthread_mutex_init(&mutex, NULL);
+  pthread_create(&id1, NULL, t1, NULL);
+  pthread_create(&id2, NULL, t1, NULL);
+  pthread_join(id1, NULL);
+  pthread_join(id2, NULL);
+
+  assert(g == 2);
+}
@@ -0,0 +1,21 @@
+#include <pthread.h>
+
+int g;
+
+void *t1(void *arg)
+{
+  int l = g;
+  g = l + 1;
+}
+
+int main()
+{
+  pthread_t id1, id2;
+
+  pthread_create(&id1, NULL, t1, NULL);
+  pthread_create(&id2, NULL, t1, NULL);
+  pthread_join(id1, NULL);
+  pthread_join(id2, NULL);
+
+  assert(g == 2);
+}
@@ -0,0 +1,10 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = nondet_uint();
+  unsigned int y = x * x;
+  if(x < 1000)
+    __ESBMC_assert(y < 1000000, "square of a small number stays small");
+  return 0;
+}
@@ -0,0 +1,11 @@
+int nondet_int();
+
+int main()
+{
+  int a[4];
+  int i = nondet_int();
+  __ESBMC_assume(i >= 0 && i < 4);
+  a[i] = i;
+  __ESBMC_assert(a[i] < 3, "stored value is in range");
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  if(x > 10)
+    assert(x != 42);
+  return 0;
+}
@@ -0,0 +1,10 @@
+int a[10];
+
+int main()
+{
+  for(int i = 0; i < 10; i++)
+    a[i] = i;
+
+  int d = 5;
+  return a[3] / d;
+}
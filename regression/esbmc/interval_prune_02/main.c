@@ -0,0 +1,9 @@
+int a[10];
+
+int main()
+{
+  int i = 0;
+  int *p = &i;
+  *p = 10;
+  return a[i];
+}
@@ -0,0 +1,17 @@
+#include <pthread.h>
+
+int a[10];
+
+void *worker(void *arg)
+{
+  int i = 10;
+  a[i] = 1;
+  return 0;
+}
+
+int main()
+{
+  pthread_t t;
+  pthread_create(&t, 0, worker, 0);
+  return 0;
+}
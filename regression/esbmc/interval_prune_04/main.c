@@ -0,0 +1,13 @@
+int a[10];
+
+void set(int i)
+{
+  a[i] = 1;
+}
+
+int main()
+{
+  void (*fp)(int) = set;
+  fp(10);
+  return 0;
+}
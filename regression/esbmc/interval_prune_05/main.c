@@ -0,0 +1,14 @@
+int a[10];
+
+void set(int i)
+{
+  a[i] = 1;
+}
+
+int main()
+{
+  void (*fp)(int) = set;
+  set(0);
+  fp(10);
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <pthread.h>
+
+int a[10];
+int n;
+
+void *worker(void *arg)
+{
+  a[n] = 1;
+  return 0;
+}
+
+int main()
+{
+  int (*create)(pthread_t *, const pthread_attr_t *, void *(*)(void *), void *) =
+    pthread_create;
+  pthread_t t;
+  create(&t, 0, worker, 0);
+  n = 10;
+  return 0;
+}
@@ -0,0 +1,23 @@
+#include <assert.h>
+
+unsigned nondet_uint();
+
+int main()
+{
+  // Uninitialised, so its contents are nondet and reads of it are only
+  // related to each other by the ackermann constraints.
+  int buf[1000000];
+  unsigned i = nondet_uint(), j = nondet_uint(), k = nondet_uint();
+  __ESBMC_assume(i < 1000000 && j < 1000000 && k < 1000000);
+
+  int x = buf[i];
+  buf[j] = x + 1;
+  int y = buf[k];
+
+  // Only holds once refinement makes reads of the same index agree.
+  if(i == k && i != j)
+    assert(x == y);
+  if(k == j)
+    assert(y == x + 1);
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <assert.h>
+
+unsigned nondet_uint();
+
+int main()
+{
+  // Uninitialised, so its contents are nondet and reads of it are only
+  // related to each other by the ackermann constraints.
+  int buf[1000000];
+  unsigned i = nondet_uint(), j = nondet_uint();
+  __ESBMC_assume(i < 1000000 && j < 1000000);
+
+  int x = buf[i];
+  int y = buf[j];
+
+  // The contents are nondet, so this fails wherever i and j differ, which
+  // refinement must not rule out.
+  assert(x == y);
+  return 0;
+}
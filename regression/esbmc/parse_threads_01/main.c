@@ -0,0 +1,10 @@
+#include <assert.h>
+
+int twice(int x);
+
+int main()
+{
+  // Only holds if twice comes from module.c rather than being left undefined.
+  assert(twice(3) == 6);
+  return 0;
+}
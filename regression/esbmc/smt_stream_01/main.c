@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int a[4];
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 4);
+
+  for(int i = 0; i < 4; i++)
+    a[i] = i * 2;
+
+  int y = a[x] + 1;
+  __ESBMC_assert(y != 7, "y reaches 7");
+  return 0;
+}
@@ -0,0 +1,7 @@
+int main()
+{
+  unsigned int x = 0;
+  while(x < 10)
+    x++;
+  assert(x == 10);
+}
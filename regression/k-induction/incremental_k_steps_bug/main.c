@@ -0,0 +1,11 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = 0;
+  while(nondet_uint())
+  {
+    x++;
+    assert(x < 3);
+  }
+}
@@ -6,21 +6,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
-extern "C"
-{
-#ifdef _WIN32
-#include <windows.h>
-#include <io.h>
-#undef small // MinGW header workaround
-#else
-#include <unistd.h>
-#endif
-}
-
 #include <c2goto/cprover_library.h>
+#include <cstdint>
 #include <cstdlib>
-#include <fstream>
-#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <unordered_set>
 #include <util/c_link.h>
 #include <util/config.h>
 
@@ -49,16 +39,6 @@ extern "C"
 #undef p
 #endif
 
-bool is_in_list(std::list<irep_idt> &list, irep_idt item)
-{
-  for(std::list<irep_idt>::const_iterator it = list.begin(); it != list.end();
-      it++)
-    if(*it == item)
-      return true;
-
-  return false;
-}
-
 void generate_symbol_deps(
   irep_idt name,
   irept irep,
@@ -112,26 +92,12 @@ void generate_symbol_deps(
   }
 }
 
-void ingest_symbol(
-  irep_idt name,
-  std::multimap<irep_idt, irep_idt> &deps,
-  std::list<irep_idt> &to_include)
-{
-  std::pair<
-    std::multimap<irep_idt, irep_idt>::const_iterator,
-    std::multimap<irep_idt, irep_idt>::const_iterator>
-    range;
-  std::multimap<irep_idt, irep_idt>::const_iterator it;
-
-  range = deps.equal_range(name);
-  if(range.first == range.second)
-    return;
-
-  for(it = range.first; it != range.second; it++)
-    to_include.push_back(it->second);
-
-  deps.erase(name);
-}
+/* Some library functions come in several flavours, chosen by the defines we
+ * pass to the frontend; if one of them is used, pull in the others too. */
+static const std::pair<const char *, const char *> extra_symbol_deps[] = {
+  {"pthread_mutex_lock", "pthread_mutex_lock_check"},
+  {"pthread_cond_wait", "pthread_cond_wait_check"},
+  {"pthread_join", "pthread_join_noswitch"}};
 
 #ifdef NO_CPROVER_LIBRARY
 void add_cprover_library(contextt &, message_handlert &)
@@ -145,15 +111,9 @@ void add_cprover_library(contextt &context, message_handlert &message_handler)
   if(config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
-  contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
-  std::multimap<irep_idt, irep_idt> symbol_deps;
-  std::list<irep_idt> to_include;
-  char symname_buffer[288];
-  FILE *f;
+  contextt store_ctx;
   uint8_t **this_clib_ptrs;
   uint64_t size;
-  int fd;
 
   if(config.ansi_c.word_size == 32)
   {
@@ -198,76 +158,53 @@ void add_cprover_library(contextt &context, message_handlert &message_handler)
     abort();
   }
 
-#ifndef _WIN32
-  sprintf(symname_buffer, "/tmp/ESBMC_XXXXXX");
-  fd = mkstemp(symname_buffer);
-  close(fd);
-#else
-  char tmpdir[256];
-  GetTempPath(sizeof(tmpdir), tmpdir);
-  GetTempFileName(tmpdir, "bmc", 0, symname_buffer);
-#endif
-  f = fopen(symname_buffer, "wb");
-  if(fwrite(this_clib_ptrs[0], size, 1, f) != 1)
+  /* Read straight out of the library image embedded in our binary, so it
+   * never has to be copied before deserializing it. */
+  goto_binary_readert library;
+  if(library.open(
+       (const char *)this_clib_ptrs[0],
+       size,
+       "<built-in-library>",
+       message_handler))
   {
-    std::cerr << "Couldn't manipulate internal C library" << std::endl;
+    std::cerr << "Failed to read C library" << std::endl;
     abort();
   }
-  fclose(f);
-
-  std::ifstream infile(symname_buffer, std::ios::in | std::ios::binary);
-  read_goto_binary(infile, new_ctx, goto_functions, message_handler);
-  infile.close();
-#ifndef _WIN32
-  unlink(symname_buffer);
-#else
-  DeleteFile(symname_buffer);
-#endif
 
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
+  /* Start from the symbols the program declares but doesn't define, and
+   * pull in whatever they use. Only the symbols that actually get pulled in
+   * are deserialized, rather than the whole library. */
+  std::unordered_set<irep_idt, irep_id_hash> pulled;
+  std::vector<irep_idt> worklist;
 
-  // Add two hacks; we migth use either pthread_mutex_lock or the checked
-  // variety; so if one version is used, pull in the other too.
-  std::pair<irep_idt, irep_idt> lockcheck(
-    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
-  symbol_deps.insert(lockcheck);
+  for(const irep_idt &name : library.symbol_names())
+  {
+    const symbolt *symbol = context.find_symbol(name);
+    if(symbol != nullptr && symbol->value.is_nil())
+      worklist.push_back(name);
+  }
 
-  std::pair<irep_idt, irep_idt> condcheck(
-    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
-  symbol_deps.insert(condcheck);
+  while(!worklist.empty())
+  {
+    irep_idt name = worklist.back();
+    worklist.pop_back();
 
-  std::pair<irep_idt, irep_idt> joincheck(
-    dstring("pthread_join"), dstring("pthread_join_noswitch"));
-  symbol_deps.insert(joincheck);
+    if(!library.has_symbol(name) || !pulled.insert(name).second)
+      continue;
 
-  /* The code just pulled into store_ctx might use other symbols in the C
-   * library. So, repeatedly search for new C library symbols that we use but
-   * haven't pulled in, then pull them in. We finish when we've made a pass
-   * that adds no new symbols. */
+    symbolt s;
+    library.read_symbol(name, s);
+    store_ctx.add(s);
 
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include](const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if(symbol != nullptr && symbol->value.is_nil())
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
-    });
+    std::multimap<irep_idt, irep_idt> symbol_deps;
+    generate_symbol_deps(s.id, s.value, symbol_deps);
+    generate_symbol_deps(s.id, s.type, symbol_deps);
+    for(const auto &dep : symbol_deps)
+      worklist.push_back(dep.second);
 
-  for(std::list<irep_idt>::const_iterator nameit = to_include.begin();
-      nameit != to_include.end();
-      nameit++)
-  {
-    symbolt *s = new_ctx.find_symbol(*nameit);
-    if(s != nullptr)
-    {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
-    }
+    for(const auto &dep : extra_symbol_deps)
+      if(name == dep.first)
+        worklist.push_back(dep.second);
   }
 
   if(c_link(context, store_ctx, message_handler, "<built-in-library>"))
@@ -12,8 +12,10 @@
 #include <clang/Frontend/FrontendActions.h>
 #include <clang/Frontend/TextDiagnosticPrinter.h>
 #include <clang/Lex/PreprocessorOptions.h>
+#include <clang/Serialization/PCHContainerOperations.h>
 #include <clang/Tooling/Tooling.h>
 #include <llvm/Option/ArgList.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/Path.h>
 #pragma GCC diagnostic pop
@@ -38,7 +40,8 @@ static clang::driver::Driver *newDriver(
 
 std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args)
+  const std::vector<std::string> &compiler_args,
+  const std::vector<virtual_filet> &virtual_files)
 {
   // Create virtual file system to add clang's headers
   llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> OverlayFileSystem(
@@ -48,6 +51,15 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
     new llvm::vfs::InMemoryFileSystem);
   OverlayFileSystem->pushOverlay(InMemoryFileSystem);
 
+  // The embedded buffers aren't null-terminated, which clang's lexer needs,
+  // so each one gets copied into a buffer that is.
+  for(const virtual_filet &file : virtual_files)
+    InMemoryFileSystem->addFile(
+      file.path,
+      0,
+      llvm::MemoryBuffer::getMemBufferCopy(
+        llvm::StringRef(file.text, file.size), file.path));
+
   llvm::IntrusiveRefCntPtr<clang::FileManager> Files(
     new clang::FileManager(clang::FileSystemOptions(), OverlayFileSystem));
 
@@ -116,3 +128,36 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
 
   return unit;
 }
+
+std::unique_ptr<clang::ASTUnit> loadAST(
+  const std::string &path,
+  const std::vector<virtual_filet> &virtual_files)
+{
+  // Loading checks every file the AST was built from against the one on disk.
+  // Clang's headers were only ever in memory, so put them back where they
+  // were; the preprocessor takes ownership of these buffers.
+  std::vector<clang::ASTUnit::RemappedFile> remapped;
+  for(const virtual_filet &file : virtual_files)
+    remapped.emplace_back(
+      file.path,
+      llvm::MemoryBuffer::getMemBufferCopy(
+        llvm::StringRef(file.text, file.size), file.path)
+        .release());
+
+  // A stale or unreadable AST is simply rebuilt, so keep quiet about it.
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> Diagnostics =
+    clang::CompilerInstance::createDiagnostics(
+      new clang::DiagnosticOptions(), new clang::IgnoringDiagConsumer());
+
+  // The unit keeps reading from the container for as long as it lives.
+  static const clang::RawPCHContainerReader PCHReader;
+  return clang::ASTUnit::LoadFromASTFile(
+    path,
+    PCHReader,
+    clang::ASTUnit::LoadEverything,
+    Diagnostics,
+    clang::FileSystemOptions(),
+    false,
+    false,
+    remapped);
+}
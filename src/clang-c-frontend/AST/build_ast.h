@@ -2,6 +2,7 @@
 #define CLANG_C_FRONTEND_AST_BUILD_AST_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -14,8 +15,23 @@ namespace clang
 class ASTUnit;
 } // namespace clang
 
+/// A file that clang finds at path, but that only exists in memory
+struct virtual_filet
+{
+  std::string path;
+  const char *text;
+  std::size_t size;
+};
+
 std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args);
+  const std::vector<std::string> &compiler_args,
+  const std::vector<virtual_filet> &virtual_files);
+
+/// Load an AST that was saved with ASTUnit::Save. Returns nullptr if it can't
+/// be loaded, including when any file it was built from has since changed.
+std::unique_ptr<clang::ASTUnit> loadAST(
+  const std::string &path,
+  const std::vector<virtual_filet> &virtual_files);
 
 #endif /* CLANG_C_FRONTEND_AST_BUILD_AST_H_ */
@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wstrict-aliasing"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <clang/Basic/Version.h>
 #include <clang/Frontend/ASTUnit.h>
 #pragma GCC diagnostic pop
 
@@ -21,8 +22,10 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #include <clang-c-frontend/clang_c_language.h>
 #include <clang-c-frontend/clang_c_main.h>
 #include <clang-c-frontend/expr2c.h>
+#include <fstream>
 #include <sstream>
 #include <util/c_link.h>
+#include <util/crypto_hash.h>
 
 languaget *new_clang_c_language()
 {
@@ -31,38 +34,24 @@ languaget *new_clang_c_language()
 
 clang_c_languaget::clang_c_languaget()
 {
-  // Create a temporary directory, to dump clang's headers
+  // Clang's headers are served from memory, under a directory that never
+  // gets created on disk. It only has to be an absolute path that doesn't
+  // shadow anything real.
   auto p = boost::filesystem::temp_directory_path();
-  if(!boost::filesystem::exists(p) || !boost::filesystem::is_directory(p))
-  {
-    std::cerr << "Can't find temporary directory (needed to dump clang headers)"
-              << std::endl;
-    abort();
-  }
-
-  // Create temporary directory
   p += "/esbmc_clang_headers";
-  boost::filesystem::create_directory(p);
-  if(!boost::filesystem::is_directory(p))
-  {
-    std::cerr
-      << "Can't create temporary directory (needed to dump clang headers)"
-      << std::endl;
-    abort();
-  }
 
   // Build the compile arguments
   build_compiler_args(std::move(p.string()));
 
-  // Dump clang headers on the temporary folder
-  dump_clang_headers(p.string());
+  // Make the clang headers visible in that directory
+  add_clang_headers(p.string());
 }
 
-void clang_c_languaget::build_compiler_args(const std::string &&tmp_dir)
+void clang_c_languaget::build_compiler_args(const std::string &&headers_dir)
 {
   compiler_args.emplace_back("clang-tool");
 
-  compiler_args.push_back("-I" + tmp_dir);
+  compiler_args.push_back("-I" + headers_dir);
 
   // Append mode arg
   switch(config.ansi_c.word_size)
@@ -191,6 +180,34 @@ void clang_c_languaget::force_file_type()
   compiler_args.push_back("c");
 }
 
+std::string clang_c_languaget::ast_cache_key(
+  const std::vector<std::string> &args,
+  const std::string &intrinsics,
+  const std::string &path)
+{
+  // Everything that goes into the AST, bar the headers the file includes:
+  // those are recorded in the AST itself, and checked when it is loaded.
+  crypto_hash h;
+  auto ingest = [&h](const std::string &str) {
+    // With the terminator, so that adjacent strings can't run together.
+    h.ingest(str.c_str(), str.size() + 1);
+  };
+
+  ingest(clang::getClangFullVersion());
+  ingest(id());
+  for(auto const &arg : args)
+    ingest(arg);
+  ingest(intrinsics);
+
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  ingest(contents.str());
+
+  h.fin();
+  return h.to_string() + ".ast";
+}
+
 bool clang_c_languaget::parse(
   const std::string &path,
   message_handlert &message_handler)
@@ -211,8 +228,31 @@ bool clang_c_languaget::parse(
   // Get intrinsics
   std::string intrinsics = internal_additions();
 
-  // Generate ASTUnit and add to our vector
-  auto AST = buildASTs(intrinsics, new_compiler_args);
+  // Generate ASTUnit, or fetch it from the cache, and add to our vector
+  std::unique_ptr<clang::ASTUnit> AST;
+
+  std::string cache_dir = config.options.get_option("ast-cache-dir");
+  std::string cached;
+  if(!cache_dir.empty())
+  {
+    cached =
+      cache_dir + "/" + ast_cache_key(new_compiler_args, intrinsics, path);
+    if(boost::filesystem::exists(cached))
+      AST = loadAST(cached, virtual_files);
+  }
+
+  if(!AST)
+  {
+    AST = buildASTs(intrinsics, new_compiler_args, virtual_files);
+
+    // Failing to save only costs us the cache hit next time.
+    if(!cached.empty() && !AST->getDiagnostics().hasErrorOccurred())
+    {
+      boost::system::error_code ec;
+      boost::filesystem::create_directories(cache_dir, ec);
+      AST->Save(cached);
+    }
+  }
 
   ASTs.push_back(std::move(AST));
 
@@ -9,6 +9,7 @@ Author:
 #ifndef CLANG_C_FRONTEND_CLANG_C_LANGUAGE_H_
 #define CLANG_C_FRONTEND_CLANG_C_LANGUAGE_H_
 
+#include <clang-c-frontend/AST/build_ast.h>
 #include <util/language.h>
 
 #define __STDC_LIMIT_MACROS
@@ -31,6 +32,13 @@ public:
   bool
   parse(const std::string &path, message_handlert &message_handler) override;
 
+  // Every file gets an ASTUnit of its own, built from this object's own
+  // arguments and virtual files, so several can be parsed at once.
+  bool parse_is_thread_safe() const override
+  {
+    return true;
+  }
+
   bool final(contextt &context, message_handlert &message_handler) override;
 
   bool typecheck(
@@ -66,10 +74,19 @@ protected:
   virtual std::string internal_additions();
   virtual void force_file_type();
 
-  void dump_clang_headers(const std::string &tmp_dir);
-  void build_compiler_args(const std::string &&tmp_dir);
+  void add_clang_headers(const std::string &headers_dir);
+  void build_compiler_args(const std::string &&headers_dir);
+
+  /// Name, under --ast-cache-dir, of the saved AST for a file parsed with
+  /// these arguments
+  std::string ast_cache_key(
+    const std::vector<std::string> &args,
+    const std::string &intrinsics,
+    const std::string &path);
 
   std::vector<std::string> compiler_args;
+  // Headers embedded in the binary, which clang reads from memory
+  std::vector<virtual_filet> virtual_files;
   std::vector<std::unique_ptr<clang::ASTUnit>> ASTs;
 };
 
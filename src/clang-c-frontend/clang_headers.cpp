@@ -1,5 +1,4 @@
 #include <clang-c-frontend/clang_c_language.h>
-#include <fstream>
 
 struct hooked_header
 {
@@ -616,18 +615,10 @@ extern "C"
     {nullptr, nullptr, nullptr}};
 }
 
-void clang_c_languaget::dump_clang_headers(const std::string &tmp_dir)
+void clang_c_languaget::add_clang_headers(const std::string &headers_dir)
 {
-  static bool dumped = false;
-  if(dumped)
-    return;
-  dumped = true;
-
   for(struct hooked_header *h = &clang_headers[0]; h->basename != nullptr; h++)
-  {
-    std::ofstream header;
-    header.open(tmp_dir + "/" + std::string(h->basename));
-    header << std::string(h->textstart, *h->textsize);
-    header.close();
-  }
+    virtual_files.push_back({headers_dir + "/" + std::string(h->basename),
+                             h->textstart,
+                             *h->textsize});
 }
@@ -11,6 +11,9 @@ Authors: Daniel Kroening, kroening@kroening.com
 #include <sys/types.h>
 
 #ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #else
 #include <windows.h>
@@ -20,6 +23,9 @@ Authors: Daniel Kroening, kroening@kroening.com
 #endif
 
 #include <ac_config.h>
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
 #include <esbmc/bmc.h>
 #include <esbmc/document_subgoals.h>
 #include <fstream>
@@ -33,6 +39,7 @@ Authors: Daniel Kroening, kroening@kroening.com
 #include <langapi/languages.h>
 #include <langapi/mode.h>
 #include <sstream>
+#include <util/crypto_hash.h>
 #include <util/i2string.h>
 #include <util/irep2.h>
 #include <util/location.h>
@@ -64,8 +71,8 @@ bmct::bmct(
       funcs,
       ns,
       options,
-      std::shared_ptr<runtime_encoded_equationt>(
-        new runtime_encoded_equationt(ns, *runtime_solver)),
+      std::shared_ptr<runtime_encoded_equationt>(new runtime_encoded_equationt(
+        ns, *runtime_solver, options.get_bool_option("smt-stream"))),
       _context,
       _message_handler);
   }
@@ -86,7 +93,77 @@ void bmct::do_cbmc(
   std::shared_ptr<symex_target_equationt> &eq)
 {
   smt_conv->set_message_handler(message_handler);
-  eq->convert(*smt_conv.get());
+
+  if(incremental_state == nullptr || smt_conv != incremental_state->solver)
+  {
+    eq->convert(*smt_conv.get());
+    return;
+  }
+
+  std::vector<incremental_statet::committed_stept> &committed =
+    incremental_state->committed_steps;
+
+  std::size_t prefix = eq->convert_incremental(*smt_conv, committed.size());
+  incremental_state->pushed = true;
+
+  auto it = eq->get_SSA_step(committed.size());
+  for(std::size_t i = committed.size(); i < prefix; i++, it++)
+    committed.push_back({it->type, it->guard, it->cond, it->lhs, it->rhs});
+}
+
+std::shared_ptr<smt_convt>
+bmct::get_incremental_solver(std::shared_ptr<symex_target_equationt> &eq)
+{
+  incremental_statet &inc = *incremental_state;
+
+  // Drop whatever the previous run added on top of the committed steps
+  if(inc.pushed)
+  {
+    inc.solver->pop_ctx();
+    inc.pushed = false;
+  }
+
+  // Only reuse the solver if the steps it holds are still a prefix of this
+  // equation. They normally are, but e.g. the names of dynamic objects are
+  // numbered globally and differ between runs.
+  bool reusable =
+    inc.solver != nullptr &&
+    inc.committed_steps.size() <= eq->get_unwind_prefix_size();
+
+  auto it = eq->SSA_steps.begin();
+  for(std::size_t i = 0; reusable && i < inc.committed_steps.size(); i++, it++)
+  {
+    const incremental_statet::committed_stept &c = inc.committed_steps[i];
+    reusable = it->type == c.type && it->guard == c.guard &&
+               it->cond == c.cond && it->lhs == c.lhs && it->rhs == c.rhs;
+  }
+
+  if(reusable)
+  {
+    std::ostringstream str;
+    str << "Reusing " << inc.committed_steps.size()
+        << " SSA steps already in the solver";
+    status(str.str());
+    return inc.solver;
+  }
+
+  inc.committed_steps.clear();
+  inc.solver = std::shared_ptr<smt_convt>(create_solver_factory(
+    "", options.get_bool_option("int-encoding"), inc.ns, options));
+
+  if(!inc.solver->can_pop_assertions())
+  {
+    warning(
+      "The solver can't retract assertions, disabling --incremental-k-steps");
+    inc.unsupported = true;
+
+    std::shared_ptr<smt_convt> solver = inc.solver;
+    inc.solver.reset();
+    incremental_state.reset();
+    return solver;
+  }
+
+  return inc.solver;
 }
 
 void bmct::successful_trace()
@@ -174,10 +251,100 @@ void bmct::error_trace(
   }
 }
 
+// Options that change how an equation is encoded, and with it possibly the
+// verdict for a formula that hashes the same.
+static const char *vcc_cache_options[] = {"int-encoding",
+                                          "fixedbv",
+                                          "floatbv",
+                                          "fp2bv",
+                                          "tuple-node-flattener",
+                                          "tuple-sym-flattener",
+                                          "array-flattener",
+                                          "smtlib-solver-prog"};
+
+static std::string vcc_cache_file(
+  const optionst &options,
+  const symex_target_equationt &eq,
+  const std::string &solver)
+{
+  crypto_hash hash;
+
+  std::string fingerprint = ESBMC_VERSION ";" + solver + ";";
+  for(const char *opt : vcc_cache_options)
+    fingerprint += std::string(opt) + "=" + options.get_option(opt) + ";";
+  hash.ingest(fingerprint.c_str(), fingerprint.size());
+
+  eq.hash(hash);
+  hash.fin();
+
+  return options.get_option("vcc-cache") + "/" + hash.to_string();
+}
+
+static smt_convt::resultt vcc_cache_lookup(const std::string &file)
+{
+  std::ifstream in(file);
+  std::string verdict;
+  if(in >> verdict)
+  {
+    if(verdict == "UNSAT")
+      return smt_convt::P_UNSATISFIABLE;
+    if(verdict == "SAT")
+      return smt_convt::P_SATISFIABLE;
+  }
+
+  return smt_convt::P_ERROR;
+}
+
+static void vcc_cache_store(const std::string &file, smt_convt::resultt res)
+{
+  boost::system::error_code ec;
+  boost::filesystem::path path(file);
+  boost::filesystem::create_directories(path.parent_path(), ec);
+
+  // Write to a private file first and move it into place, so that runs
+  // sharing the cache never see half-written entries.
+  boost::filesystem::path tmp =
+    boost::filesystem::unique_path(file + ".%%%%-%%%%-%%%%", ec);
+  {
+    std::ofstream out(tmp.string());
+    out << (res == smt_convt::P_SATISFIABLE ? "SAT" : "UNSAT") << std::endl;
+    if(!out)
+      return;
+  }
+
+  boost::filesystem::rename(tmp, path, ec);
+  if(ec)
+    boost::filesystem::remove(tmp, ec);
+}
+
 smt_convt::resultt bmct::run_decision_procedure(
   std::shared_ptr<smt_convt> &smt_conv,
   std::shared_ptr<symex_target_equationt> &eq)
 {
+  std::string cache_file;
+  if(
+    !options.get_option("vcc-cache").empty() &&
+    !options.get_bool_option("smt-during-symex") &&
+    !options.get_bool_option("smt-formula-only") &&
+    !options.get_bool_option("smt-formula-too"))
+  {
+    cache_file = vcc_cache_file(options, *eq, smt_conv->solver_text());
+    smt_convt::resultt cached = vcc_cache_lookup(cache_file);
+
+    // A cached SAT verdict comes without a model, so it can only be used
+    // when nothing is going to ask the solver for one.
+    bool need_model = !options.get_bool_option("result-only") ||
+                      options.get_bool_option("smt-model") ||
+                      options.get_bool_option("bidirectional");
+    if(
+      cached == smt_convt::P_UNSATISFIABLE ||
+      (cached == smt_convt::P_SATISFIABLE && !need_model))
+    {
+      status("Found VCC(s) result in cache " + cache_file);
+      return cached;
+    }
+  }
+
   std::string logic;
 
   if(!options.get_bool_option("int-encoding"))
@@ -204,6 +371,13 @@ smt_convt::resultt bmct::run_decision_procedure(
   str << "s";
   status(str.str());
 
+  if(options.get_bool_option("memstats"))
+  {
+    std::ostringstream cache_str;
+    smt_conv->smt_cache.print_stats(cache_str);
+    status(cache_str.str());
+  }
+
   if(
     options.get_bool_option("smt-formula-too") ||
     options.get_bool_option("smt-formula-only"))
@@ -218,9 +392,14 @@ smt_convt::resultt bmct::run_decision_procedure(
   status(ss.str());
 
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv->dec_solve();
+  smt_convt::resultt dec_result = smt_conv->solve();
   fine_timet sat_stop = current_time();
 
+  if(
+    !cache_file.empty() && (dec_result == smt_convt::P_SATISFIABLE ||
+                            dec_result == smt_convt::P_UNSATISFIABLE))
+    vcc_cache_store(cache_file, dec_result);
+
   // output runtime
   str.clear();
   str << "\nRuntime decision procedure: ";
@@ -472,6 +651,12 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   if(options.get_bool_option("schedule"))
     return run_thread(eq);
 
+  if(
+    atoi(options.get_option("parallel-interleavings").c_str()) > 1 &&
+    !options.get_bool_option("interactive-ileaves") &&
+    !options.get_bool_option("smt-during-symex"))
+    return run_parallel_interleavings(eq);
+
   smt_convt::resultt res;
   do
   {
@@ -518,6 +703,651 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   return interleaving_failed > 0 ? smt_convt::P_SATISFIABLE : res;
 }
 
+bool bmct::skip_interleaving()
+{
+  try
+  {
+    symex->get_next_formula();
+  }
+
+  catch(std::string &error_str)
+  {
+    error(error_str);
+    return false;
+  }
+
+  catch(const char *error_str)
+  {
+    error(error_str);
+    return false;
+  }
+
+  return true;
+}
+
+smt_convt::resultt
+bmct::run_parallel_interleavings(std::shared_ptr<symex_target_equationt> &eq)
+{
+#ifdef _WIN32
+  warning("--parallel-interleavings is not supported on Windows");
+  options.set_option("parallel-interleavings", "1");
+  return run(eq);
+#else
+  unsigned int num_workers =
+    atoi(options.get_option("parallel-interleavings").c_str());
+  bool all_runs = options.get_bool_option("all-runs");
+
+  // Every worker walks the same, deterministic DFS over the interleavings,
+  // but only solves those it claimed from the shared counter; the others are
+  // just symbolically executed to move on. Workers claim a new interleaving
+  // whenever they're done with one, so slow formulas don't hold up the rest.
+  struct sharedt
+  {
+    std::atomic<uint64_t> next_claim;
+    std::atomic<uint64_t> first_failed;
+    std::atomic<uint64_t> num_failed;
+    std::atomic<uint64_t> num_explored;
+    std::atomic<bool> error;
+  };
+
+  void *mem = mmap(
+    nullptr,
+    sizeof(sharedt),
+    PROT_READ | PROT_WRITE,
+    MAP_SHARED | MAP_ANONYMOUS,
+    -1,
+    0);
+  if(mem == MAP_FAILED)
+  {
+    perror("Couldn't allocate memory shared with interleaving workers");
+    abort();
+  }
+
+  sharedt *shared = new(mem) sharedt;
+  shared->next_claim = 1;
+  shared->first_failed = 0;
+  shared->num_failed = 0;
+  shared->num_explored = 0;
+  shared->error = false;
+
+  std::cout.flush();
+
+  std::vector<pid_t> workers;
+  for(unsigned int w = 0; w < num_workers; w++)
+  {
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      perror("Couldn't fork interleaving worker");
+      abort();
+    }
+
+    if(pid != 0)
+    {
+      workers.push_back(pid);
+      continue;
+    }
+
+    // Worker: only the parent reports, keep the symex and solver chatter out
+    // of its output. Errors still go to stderr.
+    int devnull = open("/dev/null", O_WRONLY);
+    if(devnull != -1)
+      dup2(devnull, STDOUT_FILENO);
+
+    uint64_t claim = shared->next_claim++;
+    for(uint64_t ileave = 1;; ileave++)
+    {
+      if(!all_runs && shared->first_failed != 0)
+        break;
+
+      if(ileave != claim)
+      {
+        if(!skip_interleaving())
+        {
+          shared->error = true;
+          break;
+        }
+      }
+      else
+      {
+        smt_convt::resultt res = run_thread(eq);
+
+        if(res == smt_convt::P_SATISFIABLE)
+        {
+          uint64_t none = 0;
+          shared->first_failed.compare_exchange_strong(none, ileave);
+          shared->num_failed++;
+        }
+        else if(res == smt_convt::P_ERROR)
+        {
+          shared->error = true;
+          break;
+        }
+
+        claim = shared->next_claim++;
+      }
+
+      uint64_t explored = shared->num_explored;
+      while(explored < ileave &&
+            !shared->num_explored.compare_exchange_weak(explored, ileave))
+        ;
+
+      if(!symex->setup_next_formula())
+        break;
+    }
+
+    _exit(0);
+  }
+
+  // The first counterexample makes the remaining workers pointless, unless
+  // we were asked to look at all of them.
+  std::vector<bool> reaped(workers.size(), false);
+  std::size_t running = workers.size();
+  bool killed = false;
+  while(running > 0)
+  {
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if(pid == -1)
+      break;
+
+    auto it = std::find(workers.begin(), workers.end(), pid);
+    if(it == workers.end())
+      continue;
+
+    reaped[it - workers.begin()] = true;
+    running--;
+    bool cancelled = (shared->first_failed != 0 && !all_runs) || shared->error;
+    if(WIFSIGNALED(status) && !cancelled)
+    {
+      std::cerr << "**** WARNING: interleaving worker crashed" << std::endl;
+      shared->error = true;
+    }
+
+    // Only the workers still running can be signalled: a reaped pid may
+    // already belong to some other process.
+    if((cancelled || shared->error) && !killed)
+    {
+      for(std::size_t i = 0; i < workers.size(); i++)
+        if(!reaped[i])
+          kill(workers[i], SIGKILL);
+      killed = true;
+    }
+  }
+
+  uint64_t first_failed = shared->first_failed;
+  interleaving_failed = shared->num_failed.load();
+  interleaving_number = shared->num_explored.load();
+  bool failed_with_error = shared->error;
+
+  shared->~sharedt();
+  munmap(mem, sizeof(sharedt));
+
+  if(first_failed == 0)
+  {
+    if(failed_with_error)
+      return smt_convt::P_ERROR;
+
+    std::ostringstream str;
+    str << "Explored " << interleaving_number << " interleavings with "
+        << num_workers << " workers";
+    status(str.str());
+    return smt_convt::P_UNSATISFIABLE;
+  }
+
+  // Replay up to the failing interleaving ourselves, so that the solver
+  // holding the counterexample lives in this process for trace building.
+  for(uint64_t ileave = 1; ileave < first_failed; ileave++)
+  {
+    if(!skip_interleaving() || !symex->setup_next_formula())
+      return smt_convt::P_ERROR;
+  }
+
+  std::cout << "*** Thread interleavings " << first_failed << " ***"
+            << std::endl;
+
+  smt_convt::resultt res = run_thread(eq);
+  if(res != smt_convt::P_SATISFIABLE)
+  {
+    error("Interleaving reported as failed by a worker could not be replayed");
+    return smt_convt::P_ERROR;
+  }
+
+  if(config.options.get_bool_option("smt-model"))
+    runtime_solver->print_model();
+
+  if(config.options.get_bool_option("bidirectional"))
+    bidirectional_search(runtime_solver, eq);
+
+  return res;
+#endif
+}
+
+smt_convt::resultt bmct::solve_with(
+  const std::string &solver_name,
+  std::shared_ptr<symex_target_equationt> &eq)
+{
+  runtime_solver = std::shared_ptr<smt_convt>(create_solver_factory(
+    solver_name, options.get_bool_option("int-encoding"), ns, options));
+  return run_decision_procedure(runtime_solver, eq);
+}
+
+smt_convt::resultt
+bmct::run_portfolio(std::shared_ptr<symex_target_equationt> &eq)
+{
+  std::vector<std::string> solvers;
+  std::istringstream names(options.get_option("portfolio"));
+  for(std::string name; std::getline(names, name, ',');)
+  {
+    if(name.empty())
+      continue;
+
+    // Every solver built in, except smtlib, which needs an external program
+    if(name == "all")
+    {
+      for(unsigned int i = 0; i < esbmc_num_solvers; i++)
+        if(esbmc_solvers[i].name != "smtlib")
+          solvers.push_back(esbmc_solvers[i].name);
+      continue;
+    }
+
+    bool built = false;
+    for(unsigned int i = 0; i < esbmc_num_solvers; i++)
+      built |= esbmc_solvers[i].name == name;
+
+    if(!built)
+    {
+      error(
+        "The " + name +
+        " solver has not been built into this version of ESBMC, sorry");
+      return smt_convt::P_ERROR;
+    }
+
+    solvers.push_back(name);
+  }
+
+  if(solvers.empty())
+  {
+    error("--portfolio needs at least one solver");
+    return smt_convt::P_ERROR;
+  }
+
+#ifdef _WIN32
+  warning("--portfolio is not supported on Windows, using " + solvers[0]);
+  return solve_with(solvers[0], eq);
+#else
+  if(solvers.size() == 1)
+    return solve_with(solvers[0], eq);
+
+  // Every solver encodes and solves the same equation in its own process,
+  // and reports its result back through a pipe.
+  std::cout.flush();
+
+  std::vector<pid_t> children;
+  std::vector<int> result_fds;
+  for(const std::string &solver : solvers)
+  {
+    int fds[2];
+    if(pipe(fds))
+    {
+      perror("Couldn't create pipe for portfolio solver");
+      abort();
+    }
+
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      perror("Couldn't fork portfolio solver");
+      abort();
+    }
+
+    if(pid == 0)
+    {
+      close(fds[0]);
+
+      int devnull = open("/dev/null", O_WRONLY);
+      if(devnull != -1)
+        dup2(devnull, STDOUT_FILENO);
+
+      smt_convt::resultt res;
+      try
+      {
+        res = solve_with(solver, eq);
+      }
+      catch(...)
+      {
+        res = smt_convt::P_ERROR;
+      }
+
+      auto const len = write(fds[1], &res, sizeof(res));
+      assert(len == sizeof(res) && "short write");
+      (void)len; //ndebug
+      _exit(0);
+    }
+
+    close(fds[1]);
+    children.push_back(pid);
+    result_fds.push_back(fds[0]);
+  }
+
+  // Take the first definitive answer. A solver that fails or gives up
+  // doesn't decide anything while others are still running.
+  std::vector<bool> reaped(children.size(), false);
+  std::size_t running = children.size();
+  int winner = -1;
+  smt_convt::resultt res = smt_convt::P_ERROR;
+  while(running > 0 && winner == -1)
+  {
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if(pid == -1)
+      break;
+
+    auto it = std::find(children.begin(), children.end(), pid);
+    if(it == children.end())
+      continue;
+
+    std::size_t i = it - children.begin();
+    reaped[i] = true;
+    running--;
+
+    smt_convt::resultt child_res;
+    if(
+      read(result_fds[i], &child_res, sizeof(child_res)) ==
+        sizeof(child_res) &&
+      (child_res == smt_convt::P_SATISFIABLE ||
+       child_res == smt_convt::P_UNSATISFIABLE))
+    {
+      winner = i;
+      res = child_res;
+    }
+  }
+
+  for(std::size_t i = 0; i < children.size(); i++)
+  {
+    if(!reaped[i])
+    {
+      kill(children[i], SIGKILL);
+      waitpid(children[i], nullptr, 0);
+    }
+    close(result_fds[i]);
+  }
+
+  if(winner == -1)
+  {
+    error("None of the portfolio solvers could decide the VCCs");
+    return smt_convt::P_ERROR;
+  }
+
+  status("Portfolio solver " + solvers[winner] + " answered first");
+
+  // The model lives in the child that found it, so build it again here for
+  // the counterexample, now that we know which solver to use.
+  if(res == smt_convt::P_SATISFIABLE)
+    return solve_with(solvers[winner], eq);
+
+  return res;
+#endif
+}
+
+smt_convt::resultt bmct::solve_claims(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<std::size_t> &claims,
+  const std::vector<bool> &ignored)
+{
+  for(std::size_t i = 0; i < eq->SSA_steps.size(); i++)
+    eq->SSA_steps[i].ignore = ignored[i];
+
+  if(options.get_bool_option("no-slice"))
+  {
+    std::size_t next = 0;
+    for(std::size_t i = 0; i < eq->SSA_steps.size(); i++)
+    {
+      if(next < claims.size() && claims[next] == i)
+        next++;
+      else if(i > claims.back() || eq->SSA_steps[i].is_assert())
+        eq->SSA_steps[i].ignore = true;
+    }
+  }
+  else
+    claim_slice(eq, claims, options.get_bool_option("slice-assumes"));
+
+  return solve_with("", eq);
+}
+
+std::vector<smt_convt::resultt> bmct::solve_claim_groups(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<std::vector<std::size_t>> &groups,
+  const std::vector<bool> &ignored,
+  unsigned int num_workers)
+{
+  std::vector<smt_convt::resultt> results(groups.size(), smt_convt::P_ERROR);
+
+#ifdef _WIN32
+  (void)num_workers;
+  for(std::size_t g = 0; g < groups.size(); g++)
+    results[g] = solve_claims(eq, groups[g], ignored);
+#else
+  // Workers pick the next unsolved group from the shared counter as soon as
+  // they're done with one, and leave its verdict in the slot for it.
+  struct sharedt
+  {
+    std::atomic<std::size_t> next_group;
+  };
+
+  std::size_t size =
+    sizeof(sharedt) + groups.size() * sizeof(std::atomic<int>);
+  void *mem = mmap(
+    nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(mem == MAP_FAILED)
+  {
+    perror("Couldn't allocate memory shared with claim workers");
+    abort();
+  }
+
+  sharedt *shared = new(mem) sharedt;
+  shared->next_group = 0;
+  std::atomic<int> *shared_results =
+    reinterpret_cast<std::atomic<int> *>(shared + 1);
+  for(std::size_t g = 0; g < groups.size(); g++)
+    new(&shared_results[g]) std::atomic<int>(smt_convt::P_ERROR);
+
+  std::cout.flush();
+
+  std::vector<pid_t> workers;
+  for(unsigned int w = 0; w < num_workers && w < groups.size(); w++)
+  {
+    pid_t pid = fork();
+    if(pid == -1)
+    {
+      perror("Couldn't fork claim worker");
+      abort();
+    }
+
+    if(pid != 0)
+    {
+      workers.push_back(pid);
+      continue;
+    }
+
+    int devnull = open("/dev/null", O_WRONLY);
+    if(devnull != -1)
+      dup2(devnull, STDOUT_FILENO);
+
+    for(std::size_t g = shared->next_group++; g < groups.size();
+        g = shared->next_group++)
+    {
+      smt_convt::resultt res;
+      try
+      {
+        res = solve_claims(eq, groups[g], ignored);
+      }
+      catch(...)
+      {
+        res = smt_convt::P_ERROR;
+      }
+
+      shared_results[g] = res;
+    }
+
+    _exit(0);
+  }
+
+  for(pid_t w : workers)
+  {
+    int status;
+    waitpid(w, &status, 0);
+    if(WIFSIGNALED(status))
+      std::cerr << "**** WARNING: claim worker crashed" << std::endl;
+  }
+
+  for(std::size_t g = 0; g < groups.size(); g++)
+    results[g] = static_cast<smt_convt::resultt>(shared_results[g].load());
+
+  munmap(mem, size);
+#endif
+
+  return results;
+}
+
+smt_convt::resultt
+bmct::run_parallel_claims(std::shared_ptr<symex_target_equationt> &eq)
+{
+  std::vector<bool> ignored;
+  std::vector<std::vector<std::size_t>> claims;
+  for(std::size_t i = 0; i < eq->SSA_steps.size(); i++)
+  {
+    const symex_target_equationt::SSA_stept &step = eq->SSA_steps[i];
+    ignored.push_back(step.ignore);
+    if(step.is_assert() && !step.ignore)
+      claims.push_back(std::vector<std::size_t>(1, i));
+  }
+
+#ifdef _WIN32
+  warning("--parallel-claims is not supported on Windows, checking serially");
+#endif
+  unsigned int num_workers =
+    std::max(atoi(options.get_option("parallel-claims").c_str()), 1);
+  std::vector<smt_convt::resultt> results =
+    solve_claim_groups(eq, claims, ignored, num_workers);
+
+  // Report every claim on its own
+  int first_failed = -1;
+  bool any_error = false;
+  for(std::size_t c = 0; c < claims.size(); c++)
+  {
+    const symex_target_equationt::SSA_stept &step =
+      eq->SSA_steps[claims[c].front()];
+
+    std::ostringstream str;
+    str << "Claim " << c + 1;
+    if(!step.comment.empty())
+      str << " (" << step.comment << ")";
+    if(step.source.is_set && step.source.pc->location.is_not_nil())
+      str << " " << step.source.pc->location;
+    str << ": ";
+
+    switch(results[c])
+    {
+    case smt_convt::P_UNSATISFIABLE:
+      str << "SUCCESSFUL";
+      break;
+    case smt_convt::P_SATISFIABLE:
+      str << "FAILED";
+      if(first_failed == -1)
+        first_failed = c;
+      break;
+    default:
+      str << "UNKNOWN";
+      any_error = true;
+    }
+
+    status(str.str());
+  }
+
+  if(first_failed == -1)
+    return any_error ? smt_convt::P_ERROR : smt_convt::P_UNSATISFIABLE;
+
+  // Solve the first failing claim again here, so that its model is around
+  // for the counterexample.
+  smt_convt::resultt res = solve_claims(eq, claims[first_failed], ignored);
+  if(res != smt_convt::P_SATISFIABLE)
+  {
+    error("Claim reported as failed by a worker could not be replayed");
+    return smt_convt::P_ERROR;
+  }
+
+  return res;
+}
+
+smt_convt::resultt
+bmct::run_parallel_encoding(std::shared_ptr<symex_target_equationt> &eq)
+{
+  std::vector<bool> ignored;
+  std::vector<std::size_t> claims;
+  for(std::size_t i = 0; i < eq->SSA_steps.size(); i++)
+  {
+    const symex_target_equationt::SSA_stept &step = eq->SSA_steps[i];
+    ignored.push_back(step.ignore);
+    if(step.is_assert() && !step.ignore)
+      claims.push_back(i);
+  }
+
+  // Every group of consecutive claims is sliced down to what those claims
+  // depend on, and encoded and solved by its own solver, in its own process
+  std::size_t num_groups = std::min<std::size_t>(
+    std::max(atoi(options.get_option("parallel-encoding").c_str()), 1),
+    claims.size());
+  std::vector<std::vector<std::size_t>> groups(num_groups);
+  for(std::size_t g = 0; g < num_groups; g++)
+    groups[g].assign(
+      claims.begin() + claims.size() * g / num_groups,
+      claims.begin() + claims.size() * (g + 1) / num_groups);
+
+#ifdef _WIN32
+  warning(
+    "--parallel-encoding is not supported on Windows, encoding serially");
+#endif
+  std::ostringstream str;
+  str << "Encoding " << claims.size() << " VCC(s) in " << num_groups
+      << " group(s) on " << num_groups << " worker process(es)";
+  status(str.str());
+
+  fine_timet start = current_time();
+  std::vector<smt_convt::resultt> results =
+    solve_claim_groups(eq, groups, ignored, num_groups);
+  fine_timet stop = current_time();
+
+  str.str("");
+  str << "Encoding and solving time: ";
+  output_time(stop - start, str);
+  str << "s";
+  status(str.str());
+
+  bool any_error = false;
+  for(std::size_t g = 0; g < num_groups; g++)
+  {
+    if(results[g] != smt_convt::P_SATISFIABLE)
+    {
+      any_error |= results[g] != smt_convt::P_UNSATISFIABLE;
+      continue;
+    }
+
+    // The model lives in the worker, so solve the first failing group again
+    // here for the counterexample
+    smt_convt::resultt res = solve_claims(eq, groups[g], ignored);
+    if(res != smt_convt::P_SATISFIABLE)
+    {
+      error("Claims reported as failed by a worker could not be replayed");
+      return smt_convt::P_ERROR;
+    }
+
+    return res;
+  }
+
+  return any_error ? smt_convt::P_ERROR : smt_convt::P_UNSATISFIABLE;
+}
+
 void bmct::bidirectional_search(
   std::shared_ptr<smt_convt> &smt_conv,
   std::shared_ptr<symex_target_equationt> &eq)
@@ -528,18 +1358,28 @@ void bmct::bidirectional_search(
        options.get_bool_option("k-induction")))
     return;
 
-  // We'll walk list of SSA steps and look for inductive assignments
+  // We'll walk list of SSA steps and look for inductive assignments, having
+  // fetched the values of all of the assertions first
+  std::vector<smt_astt> asserts;
+  for(auto const &ssait : eq->SSA_steps)
+    if(ssait.is_assert())
+      asserts.push_back(ssait.cond_ast);
+
+  std::vector<tvt> assert_values = smt_conv->l_get_each(asserts);
+
   std::vector<stack_framet> frames;
   unsigned assert_loop_number = 0;
-  for(auto ssait : eq->SSA_steps)
+  std::size_t assert_nr = 0;
+  for(auto const &ssait : eq->SSA_steps)
   {
-    if(ssait.is_assert() && smt_conv->l_get(ssait.cond_ast).is_false())
+    if(ssait.is_assert() && assert_values[assert_nr++].is_false())
     {
       if(!ssait.loop_number)
         return;
 
       // Save the location of the failed assertion
-      frames = ssait.stack_trace;
+      if(ssait.stack_trace)
+        frames = *ssait.stack_trace;
       assert_loop_number = ssait.loop_number;
 
       // We are not interested in instructions before the failed assertion yet
@@ -586,7 +1426,7 @@ void bmct::bidirectional_search(
     std::unordered_map<irep_idt, std::pair<expr2tc, expr2tc>, irep_id_hash>
       var_ssa_list;
 
-    for(auto ssait : eq->SSA_steps)
+    for(auto const &ssait : eq->SSA_steps)
     {
       if(ssait.loop_number == lit->get_original_loop_head()->loop_number)
         break;
@@ -610,14 +1450,21 @@ void bmct::bidirectional_search(
     if(!var_ssa_list.size())
       return;
 
-    // Query the solver for the value of each variable
-    std::vector<expr2tc> equalities;
-    for(auto it : var_ssa_list)
+    // Memoise the value of each variable before building the equalities
+    std::vector<expr2tc> rhs_values;
+    for(auto const &it : var_ssa_list)
     {
       // We don't support arrays or pointers
       if(is_array_type(it.second.first) || is_pointer_type(it.second.first))
         return;
 
+      rhs_values.push_back(it.second.second);
+    }
+    smt_conv->memoise_model_values(rhs_values);
+
+    std::vector<expr2tc> equalities;
+    for(auto it : var_ssa_list)
+    {
       auto lhs = build_lhs(smt_conv, it.second.first);
       auto value = build_rhs(smt_conv, it.second.second);
 
@@ -760,7 +1607,39 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
-    if(!options.get_bool_option("smt-during-symex"))
+    if(
+      !options.get_option("parallel-claims").empty() &&
+      !options.get_bool_option("smt-during-symex") &&
+      !options.get_bool_option("smt-formula-only") &&
+      !options.get_bool_option("smt-formula-too"))
+    {
+      return run_parallel_claims(eq);
+    }
+
+    if(
+      !options.get_option("parallel-encoding").empty() &&
+      !options.get_bool_option("smt-during-symex") &&
+      !options.get_bool_option("smt-formula-only") &&
+      !options.get_bool_option("smt-formula-too"))
+    {
+      return run_parallel_encoding(eq);
+    }
+
+    if(
+      incremental_state != nullptr && interleaving_number == 1 &&
+      !options.get_bool_option("smt-during-symex"))
+    {
+      runtime_solver = get_incremental_solver(eq);
+    }
+    else if(
+      !options.get_option("portfolio").empty() &&
+      !options.get_bool_option("smt-during-symex") &&
+      !options.get_bool_option("smt-formula-only") &&
+      !options.get_bool_option("smt-formula-too"))
+    {
+      return run_portfolio(eq);
+    }
+    else if(!options.get_bool_option("smt-during-symex"))
     {
       runtime_solver = std::shared_ptr<smt_convt>(create_solver_factory(
         "", options.get_bool_option("int-encoding"), ns, options));
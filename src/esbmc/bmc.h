@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_ui.h>
 #include <list>
 #include <map>
+#include <memory>
 #include <solvers/smt/smt_conv.h>
 #include <solvers/smtlib/smtlib_conv.h>
 #include <solvers/solve.h>
@@ -42,11 +43,49 @@ public:
     ui = _ui;
   }
 
+  /** Solver state kept alive between runs of the same k-induction step with
+   *  a growing unwinding bound (--incremental-k-steps). The SSA steps that
+   *  symex produces before it first reaches the unwinding bound don't depend
+   *  on the bound, so they are asserted once at the solver's base level;
+   *  only the remainder of each run is pushed and popped again. */
+  struct incremental_statet
+  {
+    explicit incremental_statet(const contextt &_context)
+      : ns(_context), pushed(false), unsupported(false)
+    {
+    }
+
+    struct committed_stept
+    {
+      goto_trace_stept::typet type;
+      expr2tc guard, cond, lhs, rhs;
+    };
+
+    // The solver keeps a reference to this, so it has to outlive each bmct
+    namespacet ns;
+    std::shared_ptr<smt_convt> solver;
+    // Steps asserted at the base level, used to check that a new equation
+    // really starts with them
+    std::vector<committed_stept> committed_steps;
+    // Whether the last run left its own context on the solver stack
+    bool pushed;
+    // Set once the solver turned out not to be able to retract assertions.
+    // Later runs then don't try again, nor warn about it again.
+    bool unsupported;
+  };
+
+  void set_incremental_state(std::shared_ptr<incremental_statet> state)
+  {
+    if(!state->unsupported)
+      incremental_state = state;
+  }
+
 protected:
   const contextt &context;
   namespacet ns;
   std::shared_ptr<smt_convt> runtime_solver;
   std::shared_ptr<reachability_treet> symex;
+  std::shared_ptr<incremental_statet> incremental_state;
 
   // use gui format
   language_uit::uit ui;
@@ -85,6 +124,38 @@ protected:
     std::shared_ptr<symex_target_equationt> &eq);
 
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
+
+  smt_convt::resultt
+  run_parallel_interleavings(std::shared_ptr<symex_target_equationt> &eq);
+
+  bool skip_interleaving();
+
+  smt_convt::resultt
+  run_portfolio(std::shared_ptr<symex_target_equationt> &eq);
+
+  smt_convt::resultt solve_with(
+    const std::string &solver_name,
+    std::shared_ptr<symex_target_equationt> &eq);
+
+  smt_convt::resultt
+  run_parallel_claims(std::shared_ptr<symex_target_equationt> &eq);
+
+  smt_convt::resultt solve_claims(
+    std::shared_ptr<symex_target_equationt> &eq,
+    const std::vector<std::size_t> &claims,
+    const std::vector<bool> &ignored);
+
+  std::vector<smt_convt::resultt> solve_claim_groups(
+    std::shared_ptr<symex_target_equationt> &eq,
+    const std::vector<std::vector<std::size_t>> &groups,
+    const std::vector<bool> &ignored,
+    unsigned int num_workers);
+
+  smt_convt::resultt
+  run_parallel_encoding(std::shared_ptr<symex_target_equationt> &eq);
+
+  std::shared_ptr<smt_convt>
+  get_incremental_solver(std::shared_ptr<symex_target_equationt> &eq);
 };
 
 #endif
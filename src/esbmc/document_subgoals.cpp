@@ -218,7 +218,7 @@ void document_subgoals(
       new_location.line(SSA_step.source.pc->location.line());
       new_location.function(SSA_step.source.pc->location.function());
 
-      claim_set[new_location].comment_set.insert(SSA_step.comment);
+      claim_set[new_location].comment_set.insert(id2string(SSA_step.comment));
     }
 
   for(claim_sett::const_iterator it = claim_set.begin(); it != claim_set.end();
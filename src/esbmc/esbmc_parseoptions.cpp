@@ -45,6 +45,7 @@ extern "C"
 #include <goto-programs/remove_unreachable.h>
 #include <goto-programs/set_claims.h>
 #include <goto-programs/show_claims.h>
+#include <util/i2string.h>
 #include <util/irep.h>
 #include <langapi/languages.h>
 #include <langapi/mode.h>
@@ -245,7 +246,22 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   if(cmdline.isset("compact-trace"))
     options.set_option("no-slice", true);
 
-  if(cmdline.isset("smt-during-symex"))
+  if(cmdline.isset("smt-stream"))
+  {
+    if(
+      cmdline.isset("program-only") || cmdline.isset("program-too") ||
+      cmdline.isset("show-vcc") || cmdline.isset("document-subgoals"))
+    {
+      std::cerr << "--smt-stream frees the SSA expressions as it converts "
+                   "them, so they can't be printed afterwards"
+                << std::endl;
+      abort();
+    }
+
+    options.set_option("smt-during-symex", true);
+  }
+
+  if(options.get_bool_option("smt-during-symex"))
   {
     std::cout << "Enabling --no-slice due to presence of --smt-during-symex";
     std::cout << std::endl;
@@ -254,7 +270,7 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
 
   if(cmdline.isset("smt-thread-guard") || cmdline.isset("smt-symex-guard"))
   {
-    if(!cmdline.isset("smt-during-symex"))
+    if(!options.get_bool_option("smt-during-symex"))
     {
       std::cerr << "Please explicitly specify --smt-during-symex if you want "
                    "to use features that involve encoding SMT during symex"
@@ -267,17 +283,7 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   if(!cmdline.isset("unlimited-k-steps"))
   {
     // Get max number of iterations
-<<<<<<< HEAD
-<<<<<<< HEAD
     BigInt max_k_step = strtoul(cmdline.getval("max-k-step"), nullptr, 10);
-=======
-    BigInt max_k_step = cmdline.isset("unlimited-k-steps")
-                          ? UINT_MAX
-                          : strtoul(cmdline.getval("max-k-step"), nullptr, 10);
->>>>>>> 2502ea648... moved code from check_step to get_command_line_options
-=======
-    BigInt max_k_step = strtoul(cmdline.getval("max-k-step"), nullptr, 10);
->>>>>>> 71409d92c... refactored max-k-step computation
 
     // Get the increment
     unsigned k_step_inc = strtoul(cmdline.getval("k-step"), nullptr, 10);
@@ -1212,6 +1218,13 @@ int esbmc_parseoptionst::do_base_case(
 
   bmc.options.set_option("unwind", integer2string(k_step));
 
+  if(opts.get_bool_option("incremental-k-steps"))
+  {
+    if(base_case_state == nullptr)
+      base_case_state = std::make_shared<bmct::incremental_statet>(context);
+    bmc.set_incremental_state(base_case_state);
+  }
+
   std::cout << "*** Checking base case, k = " << k_step << '\n';
   switch(do_bmc(bmc))
   {
@@ -1259,6 +1272,14 @@ int esbmc_parseoptionst::do_forward_condition(
 
   bmc.options.set_option("unwind", integer2string(k_step));
 
+  if(opts.get_bool_option("incremental-k-steps"))
+  {
+    if(forward_condition_state == nullptr)
+      forward_condition_state =
+        std::make_shared<bmct::incremental_statet>(context);
+    bmc.set_incremental_state(forward_condition_state);
+  }
+
   std::cout << "*** Checking forward condition, k = " << k_step << '\n';
   auto res = do_bmc(bmc);
 
@@ -1550,7 +1571,11 @@ bool esbmc_parseoptionst::process_goto_program(
       goto_termination(goto_functions, ui_message_handler);
     }
 
-    goto_check(ns, options, goto_functions);
+    unsigned discharged = goto_check(ns, options, goto_functions);
+    if(cmdline.isset("interval-analysis"))
+      status(
+        "Interval analysis discharged " + i2string(discharged) +
+        " claims before symex");
 
     // show it?
     if(cmdline.isset("show-goto-value-sets"))
@@ -1716,6 +1741,10 @@ void esbmc_parseoptionst::help()
        " -I path                      set include path\n"
        " -D macro                     define preprocessor macro\n"
        " --preprocess                 stop after preprocessing\n"
+       " --parse-threads nr           parse source files on nr threads "
+       "(default: one per core)\n"
+       " --ast-cache-dir path         reuse clang ASTs saved under path by "
+       "earlier runs on the same files\n"
        " --no-inlining                disable inlining function calls\n"
        " --full-inlining              perform full inlining of function calls\n"
        " --all-claims                 keep all claims\n"
@@ -1788,9 +1817,14 @@ void esbmc_parseoptionst::help()
        " --mathsat                    use MathSAT\n"
        " --cvc                        use CVC4\n"
        " --yices                      use Yices\n"
+       " --minisat                    use the MiniSat bit-blasting backend\n"
        " --bv                         use solver with bit-vector arithmetic\n"
        " --ir                         use solver with integer/real arithmetic\n"
        " --smtlib                     use SMT lib format\n"
+       " --portfolio solvers          run the comma-separated solvers in "
+       "parallel and take the first answer;\n"
+       "                              \"all\" stands for every solver built "
+       "in\n"
        " --smtlib-solver-prog         SMT lib program name\n"
        " --output <filename>          output VCCs in SMT lib format to given "
        "file\n"
@@ -1808,12 +1842,16 @@ void esbmc_parseoptionst::help()
        "--tuple-sym-flattener         encode tuples using our tuple to symbol "
        "API\n"
        "--array-flattener             encode arrays using our array API\n"
+       "--lazy-arrays                 with our array API, add array index "
+       "constraints on demand\n"
        "--no-return-value-opt         disable return value optimization to "
        "compute the stack size\n"
 
        "\nIncremental SMT solving\n"
        " --smt-during-symex           enable incremental SMT solving "
        "(experimental)\n"
+       " --smt-stream                 convert each SSA step into the solver "
+       "as soon as it is recorded and free it (implies --smt-during-symex)\n"
        " --smt-thread-guard           call the solver during thread "
        "exploration (experimental)\n"
        " --smt-symex-guard            call the solver during symbolic "
@@ -1853,6 +1891,11 @@ void esbmc_parseoptionst::help()
        " --max-k-step nr              set max number of iteration (default is "
        "50)\n"
        " --unlimited-k-steps          set max number of iteration to UINT_MAX\n"
+       " --incremental-k-steps        keep the solver of the base case and "
+       "forward condition between k\n"
+       "                              steps, only encoding what changed "
+       "(requires a solver with\n"
+       "                              push/pop)\n"
        " --show-cex                   print the counter-example produced by "
        "the inductive step\n"
 
@@ -1871,6 +1914,13 @@ void esbmc_parseoptionst::help()
        " --no-por                     do not do partial order reduction\n"
        " --all-runs                   check all interleavings, even if a bug "
        "was already found\n"
+       " --parallel-claims nr         check each claim on its own, on nr "
+       "worker processes\n"
+       " --parallel-encoding nr       split the claims into nr groups, each "
+       "encoded and solved on its\n"
+       "                              own worker process\n"
+       " --parallel-interleavings nr  solve the interleavings on nr worker "
+       "processes\n"
 
        "\nMiscellaneous options\n"
        " --memlimit                   configure memory limit, of form \"100m\" "
@@ -1880,8 +1930,12 @@ void esbmc_parseoptionst::help()
        " --memstats                   print memory usage statistics\n"
        " --no-simplify                do not simplify any expression\n"
        " --no-propagation             disable constant propagation\n"
+       " --vcc-cache dir              reuse solver verdicts for identical "
+       "VCCs, cached in dir\n"
+       " --hash-cons                  share structurally equal expressions in "
+       "the SSA equation\n"
        " --enable-core-dump           do not disable core dump output\n"
-       " --interval-analysis          enable interval analysis and add assumes "
-       "to the program\n"
+       " --interval-analysis          enable interval analysis, add assumes "
+       "to the program and drop the claims it proves\n"
        "\n";
 }
@@ -75,6 +75,10 @@ protected:
 
   void print_ileave_points(namespacet &ns, goto_functionst &goto_functions);
 
+  // Solvers reused across k steps with --incremental-k-steps
+  std::shared_ptr<bmct::incremental_statet> base_case_state;
+  std::shared_ptr<bmct::incremental_statet> forward_condition_state;
+
 public:
   goto_functionst goto_functions;
 };
@@ -60,6 +60,12 @@ const struct group_opt_templ all_cmd_options[] = {
      ""},
     {"force,f", boost::program_options::value<std::vector<std::string>>(), ""},
     {"preprocess", NULL, "stop after preprocessing"},
+    {"parse-threads",
+     boost::program_options::value<int>()->value_name("nr"),
+     "parse source files on nr threads (default: one per core)"},
+    {"ast-cache-dir",
+     boost::program_options::value<std::string>()->value_name("path"),
+     "reuse clang ASTs saved under path by earlier runs on the same files"},
     {"no-inlining", NULL, "disable inlining function calls"},
     {"full-inlining", NULL, "perform full inlining of function calls"},
     {"all-claims", NULL, "keep all claims"},
@@ -139,9 +145,14 @@ const struct group_opt_templ all_cmd_options[] = {
     {"mathsat", NULL, "use MathSAT"},
     {"cvc", NULL, "use CVC4"},
     {"yices", NULL, "use Yices"},
+    {"minisat", NULL, "use the MiniSat bit-blasting backend"},
     {"bv", NULL, "use solver with bit-vector arithmetic"},
     {"ir", NULL, "use solver with integer/real arithmetic"},
     {"smtlib", NULL, "use SMT lib format"},
+    {"portfolio",
+     boost::program_options::value<std::string>()->value_name("solvers"),
+     "run the comma-separated solvers in parallel and take the first answer; "
+     "\"all\" stands for every solver built in"},
     {"smtlib-solver-prog",
 
      boost::program_options::value<std::string>(),
@@ -162,6 +173,9 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "encode tuples using our tuple to symbol API"},
     {"array-flattener", NULL, "encode arrays using our array API"},
+    {"lazy-arrays",
+     NULL,
+     "with our array API, add array index constraints on demand"},
     {"no-return-value-opt",
      NULL,
      "disable return value optimization to compute the stack size"}}},
@@ -175,7 +189,11 @@ const struct group_opt_templ all_cmd_options[] = {
      "call the solver during thread exploration {experimental},"},
     {"smt-symex-guard",
      NULL,
-     "call the solver during symbolic execution {experimental},"}}},
+     "call the solver during symbolic execution {experimental},"},
+    {"smt-stream",
+     NULL,
+     "convert each SSA step into the solver as soon as it is recorded and "
+     "free it (implies --smt-during-symex)"}}},
   {"Property checking",
    {{"no-assertions", NULL, "ignore assertions"},
     {"no-bounds-check", NULL, "do not do array bounds check"},
@@ -219,6 +237,10 @@ const struct group_opt_templ all_cmd_options[] = {
      "print the counter-example produced by the inductive step"},
     {"bidirectional", NULL, ""},
     {"unlimited-k-steps", NULL, "set max number of iteration to UINT_MAX"},
+    {"incremental-k-steps",
+     NULL,
+     "keep the solver of the base case and forward condition between k "
+     "steps, only encoding what changed (requires a solver with push/pop)"},
     {"max-inductive-step",
      boost::program_options::value<int>()->default_value(-1)->value_name("nr"),
      ""}}},
@@ -236,7 +258,17 @@ const struct group_opt_templ all_cmd_options[] = {
     {"no-por", NULL, "do not do partial order reduction"},
     {"all-runs",
      NULL,
-     "check all interleavings, even if a bug was already found"}}},
+     "check all interleavings, even if a bug was already found"},
+    {"parallel-claims",
+     boost::program_options::value<int>()->value_name("nr"),
+     "check each claim on its own, on nr worker processes"},
+    {"parallel-encoding",
+     boost::program_options::value<int>()->value_name("nr"),
+     "split the claims into nr groups, each encoded and solved on its own "
+     "worker process"},
+    {"parallel-interleavings",
+     boost::program_options::value<int>()->value_name("nr"),
+     "solve the interleavings on nr worker processes"}}},
   {"Miscellaneous options",
    {
 
@@ -250,9 +282,16 @@ const struct group_opt_templ all_cmd_options[] = {
      {"enable-core-dump", NULL, "do not disable core dump output"},
      {"no-simplify", NULL, "do not simplify any expression"},
      {"no-propagation", NULL, "disable constant propagation"},
+     {"vcc-cache",
+      boost::program_options::value<std::string>()->value_name("dir"),
+      "reuse solver verdicts for identical VCCs, cached in dir"},
+     {"hash-cons",
+      NULL,
+      "share structurally equal expressions in the SSA equation"},
      {"interval-analysis",
       NULL,
-      "enable interval analysis and add assumes to the program"}}},
+      "enable interval analysis, add assumes to the program and drop the "
+      "claims it proves"}}},
 
   {"DEBUG options",
    {// Print commit hash for current binary
@@ -7,6 +7,9 @@
  \*******************************************************************/
 
 #include <goto-programs/goto_check.h>
+#include <goto-programs/interval_domain.h>
+#include <unordered_map>
+#include <unordered_set>
 #include <util/arith_tools.h>
 #include <util/array_name.h>
 #include <util/base_type.h>
@@ -15,6 +18,7 @@
 #include <util/i2string.h>
 #include <util/location.h>
 #include <util/simplify_expr.h>
+#include <vector>
 
 class goto_checkt
 {
@@ -29,12 +33,33 @@ public:
       disable_pointer_relation_check(
         options.get_bool_option("no-pointer-relation-check")),
       enable_overflow_check(options.get_bool_option("overflow-check")),
-      enable_nan_check(options.get_bool_option("nan-check"))
+      enable_nan_check(options.get_bool_option("nan-check")),
+      intervals(nullptr),
+      discharged(0),
+      creates_threads(false)
   {
   }
 
   void goto_check(goto_programt &goto_program);
 
+  /** Check the body of the named function. Only claims in functions known
+   *  by name can be dropped by the interval analysis. */
+  void goto_check(const irep_idt &function, goto_programt &goto_program);
+
+  /** Use the results of an interval analysis over goto_functions to drop
+   *  claims that hold in every state reaching them. Programs that create
+   *  threads, and functions that may be called through a pointer, are left
+   *  alone. */
+  void use_intervals(
+    const ait<interval_domaint> &analysis,
+    const goto_functionst &goto_functions);
+
+  /** Number of claims dropped because the intervals proved them. */
+  unsigned discharged_claims() const
+  {
+    return discharged;
+  }
+
 protected:
   const namespacet &ns;
   optionst &options;
@@ -89,6 +114,28 @@ protected:
   bool disable_pointer_relation_check;
   bool enable_overflow_check;
   bool enable_nan_check;
+
+  const ait<interval_domaint> *intervals;
+  unsigned discharged;
+  goto_programt::const_targett current_target;
+  irep_idt current_function;
+
+  /** Symbols that have their address taken somewhere. The interval domain
+   *  doesn't follow writes through pointers, so its bounds on these can't
+   *  be trusted. */
+  std::unordered_set<irep_idt, irep_id_hash> address_taken;
+
+  /** Functions referred to other than as the callee of a direct call,
+   *  which are then possibly called through a pointer, and the functions
+   *  those call directly. The analysis only follows direct calls from main,
+   *  so it misses what the calls it doesn't see pass in. */
+  std::unordered_set<irep_idt, irep_id_hash> maybe_indirect;
+  bool creates_threads;
+
+  void collect_address_taken(const expr2tc &expr, bool under_address);
+  void collect_function_refs(const expr2tc &expr);
+  bool uses_address_taken(const expr2tc &expr) const;
+  bool proven_by_intervals(const expr2tc &expr) const;
 };
 
 void goto_checkt::div_by_zero_check(
@@ -373,8 +420,17 @@ void goto_checkt::add_guarded_claim(
   base_type(e, ns);
   simplify(e);
 
-  if(!options.get_bool_option("all-claims") && is_true(e))
-    return;
+  if(!options.get_bool_option("all-claims"))
+  {
+    if(is_true(e))
+      return;
+
+    if(proven_by_intervals(e))
+    {
+      ++discharged;
+      return;
+    }
+  }
 
   // add the guard
   expr2tc new_expr = guard.is_true() ? e : implies2tc(guard.as_expr(), e);
@@ -550,6 +606,7 @@ void goto_checkt::goto_check(goto_programt &goto_program)
   {
     goto_programt::instructiont &i = *it;
     const locationt &loc = i.location;
+    current_target = it;
 
     new_code.clear();
     assertions.clear();
@@ -595,6 +652,135 @@ void goto_checkt::goto_check(goto_programt &goto_program)
   }
 }
 
+void goto_checkt::goto_check(
+  const irep_idt &function,
+  goto_programt &goto_program)
+{
+  current_function = function;
+  goto_check(goto_program);
+  current_function = irep_idt();
+}
+
+void goto_checkt::use_intervals(
+  const ait<interval_domaint> &analysis,
+  const goto_functionst &goto_functions)
+{
+  std::unordered_map<irep_idt, std::vector<irep_idt>, irep_id_hash> callees;
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      collect_address_taken(i_it->code, false);
+      collect_address_taken(i_it->guard, false);
+
+      if(i_it->is_function_call())
+      {
+        // A direct callee is what the analysis follows; anything else isn't
+        const code_function_call2t &call = to_code_function_call2t(i_it->code);
+        if(!is_symbol2t(call.function))
+          collect_function_refs(call.function);
+        collect_function_refs(call.ret);
+        for(const expr2tc &arg : call.operands)
+          collect_function_refs(arg);
+
+        if(is_symbol2t(call.function))
+        {
+          const irep_idt &name = to_symbol2t(call.function).thename;
+          callees[f_it->first].push_back(name);
+          creates_threads |= name == "c:@F@__ESBMC_spawn_thread" ||
+                             name == "c:@F@pthread_create";
+        }
+      }
+      else
+        collect_function_refs(i_it->code);
+
+      collect_function_refs(i_it->guard);
+    }
+
+  // Whatever an indirectly called function calls directly gets its inputs
+  // from a caller the analysis didn't see either
+  std::vector<irep_idt> worklist(maybe_indirect.begin(), maybe_indirect.end());
+  while(!worklist.empty())
+  {
+    irep_idt f = worklist.back();
+    worklist.pop_back();
+    for(const irep_idt &callee : callees[f])
+      if(maybe_indirect.insert(callee).second)
+        worklist.push_back(callee);
+  }
+
+  // The interval domain knows nothing of other threads writing to globals,
+  // so nothing it says holds in a program that creates any, however it
+  // ends up calling the functions that do so.
+  if(
+    creates_threads || maybe_indirect.count("c:@F@__ESBMC_spawn_thread") ||
+    maybe_indirect.count("c:@F@pthread_create"))
+    return;
+
+  intervals = &analysis;
+}
+
+void goto_checkt::collect_function_refs(const expr2tc &expr)
+{
+  if(is_nil_expr(expr))
+    return;
+
+  if(is_symbol2t(expr) && is_code_type(expr->type))
+    maybe_indirect.insert(to_symbol2t(expr).thename);
+
+  expr->foreach_operand(
+    [this](const expr2tc &e) { collect_function_refs(e); });
+}
+
+void goto_checkt::collect_address_taken(
+  const expr2tc &expr,
+  bool under_address)
+{
+  if(is_nil_expr(expr))
+    return;
+
+  if(is_address_of2t(expr))
+    under_address = true;
+  else if(under_address && is_symbol2t(expr))
+    address_taken.insert(to_symbol2t(expr).thename);
+
+  expr->foreach_operand([this, under_address](const expr2tc &e) {
+    collect_address_taken(e, under_address);
+  });
+}
+
+bool goto_checkt::uses_address_taken(const expr2tc &expr) const
+{
+  if(is_symbol2t(expr))
+    return address_taken.count(to_symbol2t(expr).thename) != 0;
+
+  bool res = false;
+  expr->foreach_operand([this, &res](const expr2tc &e) {
+    if(!res && !is_nil_expr(e))
+      res = uses_address_taken(e);
+  });
+
+  return res;
+}
+
+bool goto_checkt::proven_by_intervals(const expr2tc &expr) const
+{
+  if(
+    intervals == nullptr || current_function.empty() ||
+    maybe_indirect.count(current_function) || uses_address_taken(expr))
+    return false;
+
+  // Code the analysis never reached comes back as bottom, which would prove
+  // anything. It may still run, e.g. when reached through a function
+  // pointer from a function that is itself only called indirectly.
+  auto state = intervals->abstract_state_before(current_target);
+  if(state->is_bottom())
+    return false;
+
+  expr2tc cond = expr;
+  state->ai_simplify(cond, ns);
+  return is_true(cond);
+}
+
 void goto_check(
   const namespacet &ns,
   optionst &options,
@@ -604,16 +790,27 @@ void goto_check(
   goto_check.goto_check(goto_program);
 }
 
-void goto_check(
+unsigned goto_check(
   const namespacet &ns,
   optionst &options,
   goto_functionst &goto_functions)
 {
   goto_checkt goto_check(ns, options);
 
+  // The analysis is run on the program as it is now, after inlining and any
+  // instrumentation, so that its states line up with what we check.
+  ait<interval_domaint> intervals;
+  if(options.get_bool_option("interval-analysis"))
+  {
+    intervals(goto_functions, ns);
+    goto_check.use_intervals(intervals, goto_functions);
+  }
+
   for(auto &it : goto_functions.function_map)
   {
     if(!it.second.body.empty())
-      goto_check.goto_check(it.second.body);
+      goto_check.goto_check(it.first, it.second.body);
   }
+
+  return goto_check.discharged_claims();
 }
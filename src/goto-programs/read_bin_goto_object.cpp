@@ -12,23 +12,27 @@ Date: June 2006
 #include <goto-programs/goto_program_irep.h>
 #include <goto-programs/read_bin_goto_object.h>
 #include <langapi/mode.h>
+#include <sstream>
+#include <streambuf>
 #include <util/base_type.h>
 #include <util/irep_serialization.h>
 #include <util/message_stream.h>
 #include <util/namespace.h>
 #include <util/symbol_serialization.h>
 
-#define BINARY_VERSION 1
+#define BINARY_VERSION 2
 
-bool read_bin_goto_object(
+// Version 1 binaries have no index: symbols and functions are serialized one
+// after the other, sharing a single irep table, and can only be read in order.
+#define BINARY_VERSION_SEQUENTIAL 1
+
+/* Reads the magic and the version number. Returns true on error. */
+static bool read_header(
   std::istream &in,
   const std::string &filename,
-  contextt &context,
-  goto_functionst &functions,
-  message_handlert &message_handler)
+  message_streamt &message_stream,
+  unsigned &version)
 {
-  message_streamt message_stream(message_handler);
-
   {
     char hdr[4];
     hdr[0] = in.get();
@@ -53,28 +57,65 @@ bool read_bin_goto_object(
 
       message_stream.error();
 
-      return false;
+      return true;
     }
   }
 
-  irep_serializationt::ireps_containert ic;
-  irep_serializationt irepconverter(ic);
-  symbol_serializationt symbolconverter(ic);
-  goto_function_serializationt gfconverter(ic);
+  version = irep_serializationt::read_long(in);
 
+  if(version != BINARY_VERSION && version != BINARY_VERSION_SEQUENTIAL)
   {
-    unsigned version = irepconverter.read_long(in);
+    message_stream.str << "The input was compiled with a different version of "
+                       << "goto-cc, please recompile";
+    message_stream.warning();
+    return true;
+  }
 
-    if(version != BINARY_VERSION)
-    {
-      message_stream.str
-        << "The input was compiled with a different version of "
-        << "goto-cc, please recompile";
-      message_stream.warning();
-      return false;
-    }
+  return false;
+}
+
+/* Lets a record be deserialized in place, out of the reader's buffer. */
+class record_streambuft : public std::streambuf
+{
+public:
+  record_streambuft(const char *start, std::size_t size)
+  {
+    char *p = const_cast<char *>(start);
+    setg(p, p, p + size);
   }
 
+  /* How far into the buffer reading has got. */
+  std::size_t consumed() const
+  {
+    return gptr() - eback();
+  }
+};
+
+static void add_symbol(
+  const symbolt &symbol,
+  contextt &context,
+  goto_functionst &functions)
+{
+  if(!symbol.is_type && symbol.type.is_code())
+  {
+    // makes sure there is an empty function
+    // for every function symbol and fixes
+    // the function types.
+    functions.function_map[symbol.id].type = to_code_type(symbol.type);
+  }
+  context.add(symbol);
+}
+
+static void read_sequential(
+  std::istream &in,
+  contextt &context,
+  goto_functionst &functions)
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  symbol_serializationt symbolconverter(ic);
+  goto_function_serializationt gfconverter(ic);
+
   unsigned count = irepconverter.read_long(in);
 
   for(unsigned i = 0; i < count; i++)
@@ -83,15 +124,7 @@ bool read_bin_goto_object(
     symbolconverter.convert(in, t);
     symbolt symbol;
     symbol.from_irep(t);
-
-    if(!symbol.is_type && symbol.type.is_code())
-    {
-      // makes sure there is an empty function
-      // for every function symbol and fixes
-      // the function types.
-      functions.function_map[symbol.id].type = to_code_type(symbol.type);
-    }
-    context.add(symbol);
+    add_symbol(symbol, context, functions);
   }
 
   count = irepconverter.read_long(in);
@@ -104,6 +137,203 @@ bool read_bin_goto_object(
     convert(t, f.body);
     f.body_available = f.body.instructions.size() > 0;
   }
+}
+
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  contextt &context,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  message_streamt message_stream(message_handler);
+
+  unsigned version;
+  if(read_header(in, filename, message_stream, version))
+    return false;
+
+  if(version == BINARY_VERSION_SEQUENTIAL)
+  {
+    read_sequential(in, context, functions);
+    return false;
+  }
+
+  goto_binary_readert reader;
+  if(reader.load(in))
+  {
+    message_stream.str << "`" << filename << "' is a truncated goto-binary.";
+    message_stream.error();
+    return false;
+  }
+
+  for(const irep_idt &name : reader.symbol_names())
+  {
+    symbolt symbol;
+    reader.read_symbol(name, symbol);
+    add_symbol(symbol, context, functions);
+  }
+
+  for(const irep_idt &name : reader.function_names())
+  {
+    goto_functiont &f = functions.function_map[name];
+    reader.read_function(name, f.body);
+    f.body_available = f.body.instructions.size() > 0;
+  }
+
+  return false;
+}
+
+bool goto_binary_readert::open(
+  std::istream &in,
+  const std::string &filename,
+  message_handlert &message_handler)
+{
+  message_streamt message_stream(message_handler);
+
+  unsigned version;
+  if(read_header(in, filename, message_stream, version))
+    return true;
+
+  if(version != BINARY_VERSION)
+  {
+    message_stream.str << "`" << filename << "' has no index, please recompile";
+    message_stream.error();
+    return true;
+  }
+
+  if(load(in))
+  {
+    message_stream.str << "`" << filename << "' is a truncated goto-binary.";
+    message_stream.error();
+    return true;
+  }
+
+  return false;
+}
+
+bool goto_binary_readert::open(
+  const char *start,
+  std::size_t size,
+  const std::string &filename,
+  message_handlert &message_handler)
+{
+  message_streamt message_stream(message_handler);
+
+  record_streambuft buf(start, size);
+  std::istream in(&buf);
+
+  unsigned version;
+  if(read_header(in, filename, message_stream, version))
+    return true;
+
+  if(version != BINARY_VERSION)
+  {
+    message_stream.str << "`" << filename << "' has no index, please recompile";
+    message_stream.error();
+    return true;
+  }
+
+  std::size_t header = buf.consumed();
+  if(!in.good() || load(start + header, size - header))
+  {
+    message_stream.str << "`" << filename << "' is a truncated goto-binary.";
+    message_stream.error();
+    return true;
+  }
+
+  return false;
+}
+
+bool goto_binary_readert::load(std::istream &in)
+{
+  // We can't point into a stream, so take a copy of the rest of it.
+  std::ostringstream rest;
+  if(in.peek() != EOF)
+    rest << in.rdbuf();
+  storage = rest.str();
+
+  return load(storage.data(), storage.size());
+}
+
+bool goto_binary_readert::load(const char *start, std::size_t size)
+{
+  record_streambuft buf(start, size);
+  std::istream in(&buf);
+
+  std::size_t offset = 0;
+  if(
+    read_index(in, offset, symbols, symbol_order) ||
+    read_index(in, offset, functions, function_order))
+    return true;
+
+  // The records follow the index back to back, in the same order.
+  data = start + buf.consumed();
+  data_size = size - buf.consumed();
+
+  return data_size < offset;
+}
+
+bool goto_binary_readert::read_index(
+  std::istream &in,
+  std::size_t &offset,
+  recordst &records,
+  std::vector<irep_idt> &order)
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  unsigned count = irepconverter.read_long(in);
+  order.reserve(count);
+  records.reserve(count);
+
+  for(unsigned i = 0; i < count && in.good(); i++)
+  {
+    irep_idt name = irepconverter.read_string(in);
+    std::size_t size = irepconverter.read_long(in);
+
+    records[name] = recordt{offset, size};
+    order.push_back(name);
+    offset += size;
+  }
+
+  return !in.good();
+}
+
+bool goto_binary_readert::read_symbol(const irep_idt &name, symbolt &symbol)
+  const
+{
+  recordst::const_iterator it = symbols.find(name);
+  if(it == symbols.end())
+    return true;
+
+  record_streambuft buf(data + it->second.offset, it->second.size);
+  std::istream in(&buf);
+
+  irep_serializationt::ireps_containert ic;
+  symbol_serializationt symbolconverter(ic);
+
+  irept t;
+  symbolconverter.convert(in, t);
+  symbol.from_irep(t);
+  return false;
+}
+
+bool goto_binary_readert::read_function(
+  const irep_idt &name,
+  goto_programt &body) const
+{
+  recordst::const_iterator it = functions.find(name);
+  if(it == functions.end())
+    return true;
+
+  record_streambuft buf(data + it->second.offset, it->second.size);
+  std::istream in(&buf);
+
+  irep_serializationt::ireps_containert ic;
+  goto_function_serializationt gfconverter(ic);
 
+  irept t;
+  gfconverter.convert(in, t);
+  convert(t, body);
   return false;
 }
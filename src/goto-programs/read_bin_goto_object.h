@@ -12,6 +12,7 @@ Date: May 2007
 #define READ_BIN_GOTO_OBJECT_H_
 
 #include <goto-programs/goto_functions.h>
+#include <unordered_map>
 #include <util/context.h>
 #include <util/message.h>
 
@@ -22,4 +23,83 @@ bool read_bin_goto_object(
   goto_functionst &functions,
   message_handlert &msg_hndlr);
 
+/* Random access to the records of a goto-binary. Only the header and the
+ * index are decoded when the binary is opened; each symbol and function body
+ * is deserialized when it is asked for, so a user that needs a small part of
+ * a large binary (such as the C library) doesn't pay for all of it. */
+class goto_binary_readert
+{
+public:
+  /* Reads the header and the index, and keeps a copy of the remaining
+   * record data. Returns true on error, as does read_bin_goto_object.
+   * Binaries written in the old, unindexed format are rejected. */
+  bool open(
+    std::istream &in,
+    const std::string &filename,
+    message_handlert &message_handler);
+
+  /* As above, but reads the records straight out of the given buffer, which
+   * must outlive the reader; nothing is copied. */
+  bool open(
+    const char *start,
+    std::size_t size,
+    const std::string &filename,
+    message_handlert &message_handler);
+
+  /* Names of the symbols / function bodies in the binary, in file order. */
+  const std::vector<irep_idt> &symbol_names() const
+  {
+    return symbol_order;
+  }
+
+  const std::vector<irep_idt> &function_names() const
+  {
+    return function_order;
+  }
+
+  bool has_symbol(const irep_idt &name) const
+  {
+    return symbols.find(name) != symbols.end();
+  }
+
+  /* Both return true if there is no record of that name. */
+  bool read_symbol(const irep_idt &name, symbolt &symbol) const;
+  bool read_function(const irep_idt &name, goto_programt &body) const;
+
+protected:
+  struct recordt
+  {
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  typedef std::unordered_map<irep_idt, recordt, irep_id_hash> recordst;
+
+  friend bool read_bin_goto_object(
+    std::istream &,
+    const std::string &,
+    contextt &,
+    goto_functionst &,
+    message_handlert &);
+
+  /* The record area: either the caller's buffer, or our own copy of it in
+   * storage when the binary came from a stream. */
+  const char *data = nullptr;
+  std::size_t data_size = 0;
+  std::string storage;
+
+  recordst symbols, functions;
+  std::vector<irep_idt> symbol_order, function_order;
+
+  /* Reads the index and the record data that follow the header. */
+  bool load(std::istream &in);
+  bool load(const char *start, std::size_t size);
+
+  bool read_index(
+    std::istream &in,
+    std::size_t &offset,
+    recordst &records,
+    std::vector<irep_idt> &order);
+};
+
 #endif /*READ_BIN_GOTO_OBJECT_H_*/
@@ -9,49 +9,72 @@ Author: CM Wintersteiger
 #include <fstream>
 #include <goto-programs/goto_function_serialization.h>
 #include <goto-programs/write_goto_binary.h>
+#include <sstream>
 #include <util/irep_serialization.h>
 #include <util/message.h>
 #include <util/symbol_serialization.h>
 
+typedef std::vector<std::pair<irep_idt, std::string>> recordst;
+
+static void write_index(std::ostream &out, const recordst &records)
+{
+  write_long(out, records.size());
+
+  for(const auto &r : records)
+  {
+    write_string(out, r.first.as_string());
+    write_long(out, r.second.size());
+  }
+}
+
 bool write_goto_binary(
   std::ostream &out,
   const contextt &lcontext,
   goto_functionst &functions)
 {
-  // header
-  out << "GBF";
-  write_long(out, GOTO_BINARY_VERSION);
-
+  // Every symbol and function body is serialized on its own, with fresh
+  // irep and string tables, so that readers can decode any one of them
+  // without the rest. The index of names and record sizes goes first.
   irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
   symbol_serializationt symbolconverter(irepc);
   goto_function_serializationt gfconverter(irepc);
 
-  write_long(out, lcontext.size());
-
-  lcontext.foreach_operand([&symbolconverter, &out](const symbolt &s) {
-    symbolconverter.convert(s, out);
-  });
-
-  unsigned cnt = 0;
-  forall_goto_functions(it, functions)
-    if(it->second.body_available)
-      cnt++;
+  recordst symbols;
+  symbols.reserve(lcontext.size());
 
-  write_long(out, cnt);
+  lcontext.foreach_operand(
+    [&irepc, &symbolconverter, &symbols](const symbolt &s) {
+      std::ostringstream record;
+      irepc.clear();
+      symbolconverter.convert(s, record);
+      symbols.emplace_back(s.id, record.str());
+    });
 
+  recordst bodies;
   for(auto &it : functions.function_map)
   {
     if(it.second.body_available)
     {
       it.second.body.compute_location_numbers();
-      write_string(out, it.first.as_string());
-      gfconverter.convert(it.second, out);
+      std::ostringstream record;
+      irepc.clear();
+      gfconverter.convert(it.second, record);
+      bodies.emplace_back(it.first, record.str());
     }
   }
 
-  //irepconverter.output_map(f);
-  //irepconverter.output_string_map(f);
+  // header
+  out << "GBF";
+  write_long(out, GOTO_BINARY_VERSION);
+
+  write_index(out, symbols);
+  write_index(out, bodies);
+
+  for(const auto &r : symbols)
+    out.write(r.second.data(), r.second.size());
+
+  for(const auto &r : bodies)
+    out.write(r.second.data(), r.second.size());
 
   return false;
 }
@@ -9,7 +9,7 @@ Author: CM Wintersteiger
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 
-#define GOTO_BINARY_VERSION 1
+#define GOTO_BINARY_VERSION 2
 
 #include <goto-programs/goto_functions.h>
 #include <ostream>
@@ -49,33 +49,96 @@ expr2tc build_rhs(std::shared_ptr<smt_convt> &smt_conv, const expr2tc &rhs)
   return new_rhs;
 }
 
+static void
+collect_lhs_indexes(const expr2tc &lhs, std::vector<expr2tc> &model_exprs)
+{
+  // The index values that build_lhs will ask for
+  if(!is_nil_expr(lhs) && is_index2t(lhs))
+  {
+    const index2t &index = to_index2t(lhs);
+    collect_lhs_indexes(index.source_value, model_exprs);
+    model_exprs.push_back(index.index);
+  }
+}
+
 void build_goto_trace(
   const std::shared_ptr<symex_target_equationt> &target,
   std::shared_ptr<smt_convt> &smt_conv,
   goto_tracet &goto_trace,
   const bool &is_compact_trace)
 {
-  unsigned step_nr = 0;
-
+  // Work out which steps were taken from the values of their guards
+  std::vector<const symex_target_equationt::SSA_stept *> steps;
+  std::vector<smt_astt> guards;
   for(auto const &SSA_step : target->SSA_steps)
   {
     if(SSA_step.hidden && is_compact_trace)
       continue;
 
-    if(!smt_conv->l_get(SSA_step.guard_ast).is_true())
+    steps.push_back(&SSA_step);
+    guards.push_back(SSA_step.guard_ast);
+  }
+
+  std::vector<tvt> guard_values = smt_conv->l_get_each(guards);
+
+  // Then collect everything the taken steps need from the model, and
+  // memoise it before building the trace out of it, so that values shared
+  // between steps are only asked of the solver once
+  std::vector<const symex_target_equationt::SSA_stept *> taken;
+  std::vector<expr2tc> model_exprs;
+  std::vector<smt_astt> conds;
+  for(std::size_t i = 0; i < steps.size(); i++)
+  {
+    if(!guard_values[i].is_true())
       continue;
 
+    const symex_target_equationt::SSA_stept &SSA_step = *steps[i];
+    taken.push_back(&SSA_step);
+
+    if(SSA_step.is_assignment())
+    {
+      collect_lhs_indexes(SSA_step.original_lhs, model_exprs);
+
+      model_exprs.push_back(
+        is_nil_expr(SSA_step.original_rhs) ? SSA_step.rhs
+                                           : SSA_step.original_rhs);
+    }
+
+    if(SSA_step.is_output())
+      model_exprs.insert(
+        model_exprs.end(),
+        SSA_step.converted_output_args.begin(),
+        SSA_step.converted_output_args.end());
+
+    if(SSA_step.is_assert() || SSA_step.is_assume())
+      conds.push_back(SSA_step.cond_ast);
+  }
+
+  smt_conv->memoise_model_values(model_exprs);
+  std::vector<tvt> cond_values = smt_conv->l_get_each(conds);
+
+  unsigned step_nr = 0;
+  std::size_t cond_nr = 0;
+
+  for(const symex_target_equationt::SSA_stept *step : taken)
+  {
+    const symex_target_equationt::SSA_stept &SSA_step = *step;
+
     goto_trace_stept goto_trace_step;
 
     goto_trace_step.thread_nr = SSA_step.source.thread_nr;
     goto_trace_step.pc = SSA_step.source.pc;
-    goto_trace_step.comment = SSA_step.comment;
+    goto_trace_step.comment = id2string(SSA_step.comment);
     goto_trace_step.original_lhs = SSA_step.original_lhs;
     goto_trace_step.type = SSA_step.type;
     goto_trace_step.step_nr = ++step_nr;
     goto_trace_step.format_string = SSA_step.format_string;
 
-    goto_trace_step.stack_trace = SSA_step.stack_trace;
+    if(SSA_step.stack_trace)
+      goto_trace_step.stack_trace = *SSA_step.stack_trace;
+
+    if(SSA_step.is_assert() || SSA_step.is_assume())
+      goto_trace_step.guard = !cond_values[cond_nr++].is_false();
 
     if(SSA_step.is_assignment())
     {
@@ -106,9 +169,6 @@ void build_goto_trace(
       }
     }
 
-    if(SSA_step.is_assert() || SSA_step.is_assume())
-      goto_trace_step.guard = !smt_conv->l_get(SSA_step.cond_ast).is_false();
-
     goto_trace.steps.push_back(goto_trace_step);
   }
 }
@@ -139,12 +199,13 @@ void build_successful_goto_trace(
       goto_trace_step.lhs = it->lhs;
       goto_trace_step.rhs = it->rhs;
       goto_trace_step.pc = it->source.pc;
-      goto_trace_step.comment = it->comment;
+      goto_trace_step.comment = id2string(it->comment);
       goto_trace_step.original_lhs = it->original_lhs;
       goto_trace_step.type = it->type;
       goto_trace_step.step_nr = step_nr++;
       goto_trace_step.format_string = it->format_string;
-      goto_trace_step.stack_trace = it->stack_trace;
+      if(it->stack_trace)
+        goto_trace_step.stack_trace = *it->stack_trace;
     }
   }
 }
@@ -8,24 +8,90 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-symex/slice.h>
 
+symex_slicet::symbol_keyt::symbol_keyt(const symbol2t &sym)
+  : name(sym.thename.get_no()),
+    level(0),
+    level1_num(0),
+    thread_num(0),
+    node_num(0),
+    level2_num(0)
+{
+  // Only keep the numbers that are part of the symbol's name at its
+  // renaming level, so that keys compare like get_symbol_name() would.
+  switch(sym.rlevel)
+  {
+  case symbol2t::level0:
+  case symbol2t::level1_global:
+    break;
+  case symbol2t::level2:
+    level2_num = sym.level2_num;
+    node_num = sym.node_num;
+    /* fall through */
+  case symbol2t::level1:
+    level = sym.rlevel == symbol2t::level1 ? 1 : 2;
+    level1_num = sym.level1_num;
+    thread_num = sym.thread_num;
+    break;
+  case symbol2t::level2_global:
+    level = 3;
+    node_num = sym.node_num;
+    level2_num = sym.level2_num;
+    break;
+  default:
+    assert(0 && "Unrecognized renaming level enum");
+  }
+}
+
+std::size_t symex_slicet::symbol_key_hash::
+operator()(const symbol_keyt &key) const
+{
+  std::size_t h = key.name;
+  h = h * 31 + key.level;
+  h = h * 31 + key.level1_num;
+  h = h * 31 + key.thread_num;
+  h = h * 31 + key.node_num;
+  h = h * 31 + key.level2_num;
+  return h;
+}
+
 symex_slicet::symex_slicet(bool assume)
   : ignored(0),
     slice_assumes(assume),
     add_to_deps([this](const symbol2t &s) -> bool {
-      return depends.insert(s.get_symbol_name()).second;
-    })
+      return depends.insert(symbol_keyt(s)).second;
+    }),
+    check_in_deps([this](const symbol2t &s) -> bool {
+      return depends.find(symbol_keyt(s)) != depends.end();
+    }),
+    generation(0)
 {
 }
 
 bool symex_slicet::get_symbols(
   const expr2tc &expr,
-  std::function<bool(const symbol2t &)> fn)
+  const std::function<bool(const symbol2t &)> &fn)
 {
+  generation++;
+  return collect_symbols(expr, fn);
+}
+
+bool symex_slicet::collect_symbols(
+  const expr2tc &expr,
+  const std::function<bool(const symbol2t &)> &fn)
+{
+  // Anything fn found under a node we've seen was already reported then.
+  auto it = visited.emplace(expr.get(), generation);
+  if(!it.second)
+  {
+    if(it.first->second == generation)
+      return false;
+    it.first->second = generation;
+  }
+
   bool res = false;
   expr->foreach_operand([this, &fn, &res](const expr2tc &e) {
     if(!is_nil_expr(e))
-      res = get_symbols(e, fn) || res;
-    return res;
+      res = collect_symbols(e, fn) || res;
   });
 
   if(!is_symbol2t(expr))
@@ -46,13 +112,53 @@ void symex_slicet::slice(std::shared_ptr<symex_target_equationt> &eq)
     slice(*it);
 }
 
+void symex_slicet::slice(
+  std::shared_ptr<symex_target_equationt> &eq,
+  std::size_t claim)
+{
+  slice(eq, std::vector<std::size_t>(1, claim));
+}
+
+void symex_slicet::slice(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<std::size_t> &claims)
+{
+  assert(!claims.empty() && claims.back() < eq->SSA_steps.size());
+  depends.clear();
+
+  // Walking backwards, next is the last group member not yet reached
+  std::vector<std::size_t>::const_reverse_iterator next = claims.rbegin();
+  for(std::size_t i = eq->SSA_steps.size(); i-- > 0;)
+  {
+    symex_target_equationt::SSA_stept &SSA_step = eq->SSA_steps[i];
+    bool in_group = next != claims.rend() && *next == i;
+    if(in_group)
+    {
+      assert(SSA_step.is_assert());
+      next++;
+    }
+
+    if(i > claims.back() || (!in_group && SSA_step.is_assert()))
+    {
+      if(!SSA_step.ignore)
+      {
+        SSA_step.ignore = true;
+        ++ignored;
+      }
+      continue;
+    }
+
+    slice(SSA_step);
+  }
+}
+
 void symex_slicet::slice(symex_target_equationt::SSA_stept &SSA_step)
 {
   switch(SSA_step.type)
   {
   case goto_trace_stept::ASSERT:
     get_symbols(SSA_step.guard, add_to_deps);
-    get_symbols(SSA_step.cond, add_to_deps);
+    collect_symbols(SSA_step.cond, add_to_deps);
     break;
 
   case goto_trace_stept::ASSUME:
@@ -61,7 +167,7 @@ void symex_slicet::slice(symex_target_equationt::SSA_stept &SSA_step)
     else
     {
       get_symbols(SSA_step.guard, add_to_deps);
-      get_symbols(SSA_step.cond, add_to_deps);
+      collect_symbols(SSA_step.cond, add_to_deps);
     }
     break;
 
@@ -83,10 +189,6 @@ void symex_slicet::slice(symex_target_equationt::SSA_stept &SSA_step)
 
 void symex_slicet::slice_assume(symex_target_equationt::SSA_stept &SSA_step)
 {
-  auto check_in_deps = [this](const symbol2t &s) -> bool {
-    return depends.find(s.get_symbol_name()) != depends.end();
-  };
-
   if(!get_symbols(SSA_step.cond, check_in_deps))
   {
     // we don't really need it
@@ -97,7 +199,7 @@ void symex_slicet::slice_assume(symex_target_equationt::SSA_stept &SSA_step)
   {
     // If we need it, add the symbols to dependency
     get_symbols(SSA_step.guard, add_to_deps);
-    get_symbols(SSA_step.cond, add_to_deps);
+    collect_symbols(SSA_step.cond, add_to_deps);
   }
 }
 
@@ -105,10 +207,6 @@ void symex_slicet::slice_assignment(symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  auto check_in_deps = [this](const symbol2t &s) -> bool {
-    return depends.find(s.get_symbol_name()) != depends.end();
-  };
-
   if(!get_symbols(SSA_step.lhs, check_in_deps))
   {
     // we don't really need it
@@ -118,11 +216,11 @@ void symex_slicet::slice_assignment(symex_target_equationt::SSA_stept &SSA_step)
   else
   {
     get_symbols(SSA_step.guard, add_to_deps);
-    get_symbols(SSA_step.rhs, add_to_deps);
+    collect_symbols(SSA_step.rhs, add_to_deps);
 
     // Remove this symbol as we won't be seeing any references to it further
     // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
+    depends.erase(symbol_keyt(to_symbol2t(SSA_step.lhs)));
   }
 }
 
@@ -130,10 +228,6 @@ void symex_slicet::slice_renumber(symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  auto check_in_deps = [this](const symbol2t &s) -> bool {
-    return depends.find(s.get_symbol_name()) != depends.end();
-  };
-
   if(!get_symbols(SSA_step.lhs, check_in_deps))
   {
     // we don't really need it
@@ -151,6 +245,26 @@ BigInt slice(std::shared_ptr<symex_target_equationt> &eq, bool slice_assumes)
   return symex_slice.ignored;
 }
 
+BigInt claim_slice(
+  std::shared_ptr<symex_target_equationt> &eq,
+  std::size_t claim,
+  bool slice_assumes)
+{
+  symex_slicet symex_slice(slice_assumes);
+  symex_slice.slice(eq, claim);
+  return symex_slice.ignored;
+}
+
+BigInt claim_slice(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<std::size_t> &claims,
+  bool slice_assumes)
+{
+  symex_slicet symex_slice(slice_assumes);
+  symex_slice.slice(eq, claims);
+  return symex_slice.ignored;
+}
+
 BigInt simple_slice(std::shared_ptr<symex_target_equationt> &eq)
 {
   BigInt ignored = 0;
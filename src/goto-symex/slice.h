@@ -11,10 +11,20 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-symex/renaming.h>
 #include <goto-symex/symex_target_equation.h>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 BigInt slice(std::shared_ptr<symex_target_equationt> &eq, bool slice_assume);
 BigInt simple_slice(std::shared_ptr<symex_target_equationt> &eq);
+BigInt claim_slice(
+  std::shared_ptr<symex_target_equationt> &eq,
+  std::size_t claim,
+  bool slice_assume);
+BigInt claim_slice(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<std::size_t> &claims,
+  bool slice_assume);
 
 class symex_slicet
 {
@@ -22,16 +32,70 @@ public:
   symex_slicet(bool assume);
   void slice(std::shared_ptr<symex_target_equationt> &eq);
 
-  typedef std::unordered_set<std::string> symbol_sett;
+  /** Slice with respect to the single assertion at position claim in the
+   *  equation's steps: every other assertion, and anything recorded after
+   *  it, is ignored. */
+  void slice(std::shared_ptr<symex_target_equationt> &eq, std::size_t claim);
+
+  /** Slice with respect to a group of assertions, given by their positions
+   *  in ascending order. Like the above, with every assertion outside the
+   *  group ignored. */
+  void slice(
+    std::shared_ptr<symex_target_equationt> &eq,
+    const std::vector<std::size_t> &claims);
+
+  /** Identifies an SSA symbol the way symbol2t::get_symbol_name() does,
+   *  by its interned name and the renaming numbers that name includes,
+   *  without building the string. */
+  struct symbol_keyt
+  {
+    symbol_keyt(const symbol2t &sym);
+
+    unsigned int name;
+    unsigned int level;
+    unsigned int level1_num;
+    unsigned int thread_num;
+    unsigned int node_num;
+    unsigned int level2_num;
+
+    bool operator==(const symbol_keyt &ref) const
+    {
+      return name == ref.name && level == ref.level &&
+             level1_num == ref.level1_num && thread_num == ref.thread_num &&
+             node_num == ref.node_num && level2_num == ref.level2_num;
+    }
+  };
+
+  struct symbol_key_hash
+  {
+    std::size_t operator()(const symbol_keyt &key) const;
+  };
+
+  typedef std::unordered_set<symbol_keyt, symbol_key_hash> symbol_sett;
   symbol_sett depends;
   BigInt ignored;
 
 protected:
   bool slice_assumes;
   std::function<bool(const symbol2t &)> add_to_deps;
+  std::function<bool(const symbol2t &)> check_in_deps;
+
+  /** Nodes already walked, stamped with the get_symbols call that walked
+   *  them; only a stamp equal to generation counts as visited. Expressions
+   *  coming out of symex are DAGs with a lot of sharing (guards and phi
+   *  merges especially), which must not be re-traversed per path. Stamping
+   *  rather than clearing keeps each call proportional to its expression. */
+  std::unordered_map<const expr2t *, unsigned int> visited;
+  unsigned int generation;
 
-  bool
-  get_symbols(const expr2tc &expr, std::function<bool(const symbol2t &)> fn);
+  /** Call fn on every symbol in expr, each shared subexpression once.
+   *  @return true if fn returned true for any of them */
+  bool get_symbols(
+    const expr2tc &expr,
+    const std::function<bool(const symbol2t &)> &fn);
+  bool collect_symbols(
+    const expr2tc &expr,
+    const std::function<bool(const symbol2t &)> &fn);
 
   void slice(symex_target_equationt::SSA_stept &SSA_step);
   void slice_assume(symex_target_equationt::SSA_stept &SSA_step);
@@ -213,6 +213,8 @@ void goto_symext::symex_function_call_code(const expr2tc &expr)
   // see if it's too much
   if(get_unwind_recursion(identifier, unwinding_counter))
   {
+    target->unwind_bound_reached();
+
     if(!no_unwinding_assertions)
     {
       claim(gen_false_expr(), "recursion unwinding assertion");
@@ -111,6 +111,9 @@ void goto_symext::symex_goto(const expr2tc &old_guard)
 
     if(get_unwind(cur_state->source, unwind))
     {
+      if(unwind_set.count(instruction.loop_number) == 0)
+        target->unwind_bound_reached();
+
       loop_bound_exceeded(new_guard);
 
       // reset unwinding
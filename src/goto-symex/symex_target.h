@@ -92,6 +92,13 @@ public:
 
   virtual void push_ctx() = 0;
   virtual void pop_ctx() = 0;
+
+  // Called whenever symex stops unwinding a loop or a recursion because the
+  // global unwinding bound was reached. Everything recorded before the first
+  // such call is the same for any larger bound.
+  virtual void unwind_bound_reached()
+  {
+  }
 };
 
 class stack_framet
@@ -33,20 +33,33 @@ void symex_target_equationt::assignment(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.lhs = lhs;
+  SSA_step.guard = intern(guard);
+  SSA_step.lhs = intern(lhs);
   SSA_step.original_lhs = original_lhs;
   SSA_step.original_rhs = original_rhs;
-  SSA_step.rhs = rhs;
+  SSA_step.rhs = intern(rhs);
   SSA_step.hidden = hidden;
-  SSA_step.cond = equality2tc(lhs, rhs);
+  SSA_step.cond = intern(equality2tc(SSA_step.lhs, SSA_step.rhs));
   SSA_step.type = goto_trace_stept::ASSIGNMENT;
   SSA_step.source = source;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = intern_stack_trace(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if(debug_print)
     SSA_step.output(ns, std::cout);
+
+  step_recorded();
+}
+
+std::shared_ptr<const std::vector<stack_framet>>
+symex_target_equationt::intern_stack_trace(
+  std::vector<stack_framet> &&stack_trace)
+{
+  if(last_stack_trace == nullptr || *last_stack_trace != stack_trace)
+    last_stack_trace =
+      std::make_shared<const std::vector<stack_framet>>(std::move(stack_trace));
+
+  return last_stack_trace;
 }
 
 void symex_target_equationt::output(
@@ -66,6 +79,8 @@ void symex_target_equationt::output(
 
   if(debug_print)
     SSA_step.output(ns, std::cout);
+
+  step_recorded();
 }
 
 void symex_target_equationt::assumption(
@@ -77,14 +92,16 @@ void symex_target_equationt::assumption(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.cond = cond;
+  SSA_step.guard = intern(guard);
+  SSA_step.cond = intern(cond);
   SSA_step.type = goto_trace_stept::ASSUME;
   SSA_step.source = source;
   SSA_step.loop_number = loop_number;
 
   if(debug_print)
     SSA_step.output(ns, std::cout);
+
+  step_recorded();
 }
 
 void symex_target_equationt::assertion(
@@ -98,16 +115,18 @@ void symex_target_equationt::assertion(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.cond = cond;
+  SSA_step.guard = intern(guard);
+  SSA_step.cond = intern(cond);
   SSA_step.type = goto_trace_stept::ASSERT;
   SSA_step.source = source;
   SSA_step.comment = msg;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = intern_stack_trace(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if(debug_print)
     SSA_step.output(ns, std::cout);
+
+  step_recorded();
 }
 
 void symex_target_equationt::renumber(
@@ -129,6 +148,8 @@ void symex_target_equationt::renumber(
 
   if(debug_print)
     SSA_step.output(ns, std::cout);
+
+  step_recorded();
 }
 
 void symex_target_equationt::convert(smt_convt &smt_conv)
@@ -144,6 +165,70 @@ void symex_target_equationt::convert(smt_convt &smt_conv)
       smt_conv.make_n_ary(&smt_conv, &smt_convt::mk_or, assertions));
 }
 
+void symex_target_equationt::unwind_bound_reached()
+{
+  if(unwind_prefix_size == std::numeric_limits<std::size_t>::max())
+    unwind_prefix_size = SSA_steps.size();
+}
+
+std::size_t symex_target_equationt::convert_incremental(
+  smt_convt &smt_conv,
+  std::size_t committed)
+{
+  smt_convt::ast_vec assertions;
+  smt_astt assumpt_ast = smt_conv.convert_ast(gen_true_expr());
+
+  std::size_t prefix = get_unwind_prefix_size();
+  assert(committed <= prefix);
+
+  SSA_stepst::iterator it = SSA_steps.begin();
+  for(std::size_t i = 0; i < committed; i++, it++)
+  {
+    // Already asserted by a previous run: only fetch the handles to the
+    // guards and conditions back from the cache, they're needed for the
+    // property and for building traces.
+    SSA_stept &step = *it;
+    step.ignore = false;
+    step.guard_ast = smt_conv.convert_ast(step.guard);
+
+    if(step.is_assert())
+    {
+      step.cond_ast =
+        smt_conv.imply_ast(assumpt_ast, smt_conv.convert_ast(step.cond));
+      assertions.push_back(smt_conv.invert_ast(step.cond_ast));
+    }
+    else if(step.is_assume())
+    {
+      step.cond_ast = smt_conv.convert_ast(step.cond);
+      assumpt_ast = smt_conv.mk_and(assumpt_ast, step.cond_ast);
+    }
+    else if(step.is_output())
+    {
+      step.converted_output_args.clear();
+      convert_internal_step(smt_conv, assumpt_ast, assertions, step);
+    }
+  }
+
+  // Whatever is committed now stays in the solver for all later runs, so it
+  // must not be sliced away based on this run's properties.
+  for(std::size_t i = committed; i < prefix; i++, it++)
+  {
+    it->ignore = false;
+    convert_internal_step(smt_conv, assumpt_ast, assertions, *it);
+  }
+
+  smt_conv.push_ctx();
+
+  for(; it != SSA_steps.end(); it++)
+    convert_internal_step(smt_conv, assumpt_ast, assertions, *it);
+
+  if(!assertions.empty())
+    smt_conv.assert_ast(
+      smt_conv.make_n_ary(&smt_conv, &smt_convt::mk_or, assertions));
+
+  return prefix;
+}
+
 void symex_target_equationt::convert_internal_step(
   smt_convt &smt_conv,
   smt_astt &assumpt_ast,
@@ -329,6 +414,28 @@ operator<<(std::ostream &out, const symex_target_equationt &equation)
   return out;
 }
 
+void symex_target_equationt::hash(crypto_hash &hash) const
+{
+  for(const auto &SSA_step : SSA_steps)
+  {
+    // Output steps only bind fresh symbols, they don't constrain anything
+    if(SSA_step.ignore || SSA_step.is_output() || SSA_step.is_skip())
+      continue;
+
+    uint8_t type = SSA_step.type;
+    hash.ingest(&type, sizeof(type));
+    SSA_step.guard->hash(hash);
+
+    if(SSA_step.is_renumber())
+    {
+      SSA_step.lhs->hash(hash);
+      SSA_step.rhs->hash(hash);
+    }
+    else
+      SSA_step.cond->hash(hash);
+  }
+}
+
 void symex_target_equationt::check_for_duplicate_assigns() const
 {
   std::map<std::string, unsigned int> countmap;
@@ -361,65 +468,58 @@ void symex_target_equationt::check_for_duplicate_assigns() const
 
 unsigned int symex_target_equationt::clear_assertions()
 {
-  unsigned int num_asserts = 0;
-
-  for(SSA_stepst::iterator it = SSA_steps.begin(); it != SSA_steps.end(); it++)
-  {
-    if(it->type == goto_trace_stept::ASSERT)
-    {
-      SSA_stepst::iterator it2 = it;
-      it--;
-      SSA_steps.erase(it2);
-      num_asserts++;
-    }
-  }
+  auto it = std::remove_if(
+    SSA_steps.begin(), SSA_steps.end(), [](const SSA_stept &step) {
+      return step.type == goto_trace_stept::ASSERT;
+    });
+  unsigned int num_asserts = std::distance(it, SSA_steps.end());
+  SSA_steps.erase(it, SSA_steps.end());
 
   return num_asserts;
 }
 
 runtime_encoded_equationt::runtime_encoded_equationt(
   const namespacet &_ns,
-  smt_convt &_conv)
-  : symex_target_equationt(_ns), conv(_conv)
+  smt_convt &_conv,
+  bool _streaming)
+  : symex_target_equationt(_ns),
+    conv(_conv),
+    cvt_progress(0),
+    streaming(_streaming)
 {
   assert_vec_list.emplace_back();
   assumpt_chain.push_back(conv.convert_ast(gen_true_expr()));
-  cvt_progress = SSA_steps.end();
 }
 
 void runtime_encoded_equationt::flush_latest_instructions()
 {
-  if(SSA_steps.size() == 0)
-    return;
-
-  SSA_stepst::iterator run_it = cvt_progress;
-  // Scenarios:
-  // * We're at the start of running, in which case cvt_progress == end
-  // * We're in the middle, but nothing is left to push, so run_it + 1 == end
-  // * We're in the middle, and there's more to convert.
-  if(run_it == SSA_steps.end())
+  // Convert everything recorded since the last flush.
+  for(; cvt_progress < SSA_steps.size(); ++cvt_progress)
   {
-    run_it = SSA_steps.begin();
-  }
-  else
-  {
-    run_it++;
-    if(run_it == SSA_steps.end())
-    {
-      // There is in fact, nothing to do
-      return;
-    }
+    SSA_stept &step = SSA_steps[cvt_progress];
+    convert_internal_step(
+      conv, assumpt_chain.back(), assert_vec_list.back(), step);
 
-    // Just roll on
+    if(streaming)
+      release_exprs(step);
   }
+}
 
-  // Now iterate from the start insn to convert, to the end of the list.
-  for(; run_it != SSA_steps.end(); ++run_it)
-    convert_internal_step(
-      conv, assumpt_chain.back(), assert_vec_list.back(), *run_it);
+void runtime_encoded_equationt::step_recorded()
+{
+  if(streaming)
+    flush_latest_instructions();
+}
 
-  run_it--;
-  cvt_progress = run_it;
+void runtime_encoded_equationt::release_exprs(SSA_stept &step)
+{
+  // What's left is what build_goto_trace needs: the ASTs of the guard and
+  // condition, the lhs and the original names. An assignment's value is
+  // the value of its lhs, which the solver still knows, so the rhs goes too.
+  step.guard = expr2tc();
+  step.cond = expr2tc();
+  step.rhs = step.is_assignment() ? step.lhs : expr2tc();
+  step.output_args.clear();
 }
 
 void runtime_encoded_equationt::push_ctx()
@@ -435,13 +535,8 @@ void runtime_encoded_equationt::push_ctx()
 
 void runtime_encoded_equationt::pop_ctx()
 {
-  SSA_stepst::iterator it = scoped_end_points.back();
-  cvt_progress = it;
-
-  if(SSA_steps.size() != 0)
-    ++it;
-
-  SSA_steps.erase(it, SSA_steps.end());
+  cvt_progress = scoped_end_points.back();
+  SSA_steps.erase(SSA_steps.begin() + cvt_progress, SSA_steps.end());
 
   conv.pop_ctx();
   scoped_end_points.pop_back();
@@ -475,7 +570,7 @@ std::shared_ptr<symex_targett> runtime_encoded_equationt::clone() const
     "cloned when it contains data");
   auto nthis = std::shared_ptr<runtime_encoded_equationt>(
     new runtime_encoded_equationt(*this));
-  nthis->cvt_progress = nthis->SSA_steps.end();
+  nthis->cvt_progress = 0;
   return nthis;
 }
 
@@ -504,11 +599,11 @@ tvt runtime_encoded_equationt::ask_solver_question(const expr2tc &question)
   // results are true, false, both.
   push_ctx();
   conv.assert_ast(q);
-  smt_convt::resultt res1 = conv.dec_solve();
+  smt_convt::resultt res1 = conv.solve();
   pop_ctx();
   push_ctx();
   conv.assert_ast(conv.invert_ast(q));
-  smt_convt::resultt res2 = conv.dec_solve();
+  smt_convt::resultt res2 = conv.solve();
   pop_ctx();
 
   // So; which result?
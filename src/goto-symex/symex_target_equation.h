@@ -9,17 +9,22 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_BASIC_SYMEX_EQUATION_H
 #define CPROVER_BASIC_SYMEX_EQUATION_H
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <goto-programs/goto_program.h>
 #include <goto-symex/goto_trace.h>
 #include <goto-symex/symex_target.h>
+#include <limits>
 #include <list>
 #include <map>
 #include <solvers/smt/smt_conv.h>
 #include <util/config.h>
+#include <util/crypto_hash.h>
 #include <util/irep2.h>
+#include <util/irep2_pool.h>
 #include <util/namespace.h>
 #include <vector>
 
@@ -28,11 +33,14 @@ class symex_target_equationt : public symex_targett
 public:
   class SSA_stept;
 
-  symex_target_equationt(const namespacet &_ns) : ns(_ns)
+  symex_target_equationt(const namespacet &_ns)
+    : unwind_prefix_size(std::numeric_limits<std::size_t>::max()), ns(_ns)
   {
     debug_print = config.options.get_bool_option("symex-ssa-trace");
     ssa_trace = config.options.get_bool_option("ssa-trace");
     ssa_smt_trace = config.options.get_bool_option("ssa-smt-trace");
+    if(config.options.get_bool_option("hash-cons"))
+      expr_pool = std::make_shared<irep2_poolt>();
   }
 
   // assignment to a variable - must be symbol
@@ -79,7 +87,31 @@ public:
     const expr2tc &size,
     const sourcet &source) override;
 
+  void unwind_bound_reached() override;
+
   virtual void convert(smt_convt &smt_conv);
+
+  /**
+   *  Convert into a solver that is reused across growing unwinding bounds.
+   *  The solver must already hold, at its base context level, the first
+   *  `committed` steps of an equation whose steps are identical to ours.
+   *  Steps up to the unwinding prefix are added at the base level too, the
+   *  remainder (and the property) in a freshly pushed context, which the
+   *  caller has to pop once it is done with the result.
+   *  @param smt_conv Solver to convert into; must support popping assertions
+   *  @param committed Number of leading steps already asserted in smt_conv
+   *  @return Number of leading steps asserted at the base level afterwards
+   */
+  std::size_t convert_incremental(smt_convt &smt_conv, std::size_t committed);
+
+  /**
+   *  Number of leading steps that don't depend on the unwinding bound.
+   */
+  std::size_t get_unwind_prefix_size() const
+  {
+    return std::min(unwind_prefix_size, SSA_steps.size());
+  }
+
   void convert_internal_step(
     smt_convt &smt_conv,
     smt_astt &assumpt_ast,
@@ -94,8 +126,8 @@ public:
 
     // One stack trace recorded per function activation record. Valid for
     // assignment and assert steps only. In reverse order (most recent in idx
-    // 0).
-    std::vector<stack_framet> stack_trace;
+    // 0). Consecutive steps from the same frames share one trace.
+    std::shared_ptr<const std::vector<stack_framet>> stack_trace;
 
     bool is_assert() const
     {
@@ -130,7 +162,7 @@ public:
 
     // for ASSUME/ASSERT
     expr2tc cond;
-    std::string comment;
+    irep_idt comment;
 
     // for OUTPUT
     std::string format_string;
@@ -170,18 +202,15 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // Steps are only ever appended or truncated, so a deque gives us chunked
+  // storage with stable references and O(1) indexing.
+  typedef std::deque<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(unsigned s)
   {
-    SSA_stepst::iterator it = SSA_steps.begin();
-    for(; s != 0; s--)
-    {
-      assert(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    assert(s <= SSA_steps.size());
+    return SSA_steps.begin() + s;
   }
 
   void output(std::ostream &out) const;
@@ -189,9 +218,17 @@ public:
 
   void check_for_duplicate_assigns() const;
 
+  /**
+   *  Ingest everything that convert() would hand to the solver: the type,
+   *  guard and condition of every step that wasn't sliced away.
+   */
+  void hash(crypto_hash &hash) const;
+
   void clear()
   {
     SSA_steps.clear();
+    last_stack_trace.reset();
+    unwind_prefix_size = std::numeric_limits<std::size_t>::max();
   }
 
   unsigned int clear_assertions();
@@ -207,6 +244,30 @@ public:
   void pop_ctx() override;
 
 protected:
+  // Number of steps recorded when the unwinding bound was first reached
+  std::size_t unwind_prefix_size;
+
+  /** Expressions recorded into steps are interned here when hash-consing is
+   *  enabled. Shared with our clones, so that all interleavings explored by
+   *  one symex run use the same nodes. */
+  std::shared_ptr<irep2_poolt> expr_pool;
+
+  // Stack trace of the most recently recorded step
+  std::shared_ptr<const std::vector<stack_framet>> last_stack_trace;
+
+  std::shared_ptr<const std::vector<stack_framet>>
+  intern_stack_trace(std::vector<stack_framet> &&stack_trace);
+
+  const expr2tc &intern(const expr2tc &expr) const
+  {
+    return expr_pool ? expr_pool->intern(expr) : expr;
+  }
+
+  /** Called once a step has been appended to SSA_steps. */
+  virtual void step_recorded()
+  {
+  }
+
   const namespacet &ns;
   bool debug_print;
   bool ssa_trace;
@@ -220,7 +281,13 @@ public:
   {
   };
 
-  runtime_encoded_equationt(const namespacet &_ns, smt_convt &conv);
+  /** @param streaming Convert each step as soon as it's recorded, and drop
+   *  the expressions that only conversion needed, rather than converting in
+   *  batches whenever symex asks the solver something. */
+  runtime_encoded_equationt(
+    const namespacet &_ns,
+    smt_convt &conv,
+    bool streaming = false);
 
   void push_ctx() override;
   void pop_ctx() override;
@@ -235,16 +302,16 @@ public:
   smt_convt &conv;
   std::list<smt_convt::ast_vec> assert_vec_list;
   std::list<smt_astt> assumpt_chain;
-  std::list<SSA_stepst::iterator> scoped_end_points;
-  SSA_stepst::iterator cvt_progress;
-};
+  // Number of leading steps converted at each pushed context
+  std::list<std::size_t> scoped_end_points;
+  // Number of leading steps converted so far
+  std::size_t cvt_progress;
+  bool streaming;
 
-extern inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a) < &(*b);
-}
+protected:
+  void step_recorded() override;
+  void release_exprs(SSA_stept &step);
+};
 
 std::ostream &
 operator<<(std::ostream &out, const symex_target_equationt::SSA_stept &step);
@@ -6,10 +6,14 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 
 \*******************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <fstream>
 #include <langapi/language_ui.h>
 #include <langapi/mode.h>
 #include <memory>
+#include <thread>
 #include <util/i2string.h>
 #include <util/show_symbol_table.h>
 
@@ -33,23 +37,94 @@ language_uit::language_uit(const cmdlinet &__cmdline)
 
 bool language_uit::parse()
 {
+  // Set every file up first, serially: this is cheap, and creating language
+  // objects isn't something that can be done from several threads at once.
+  std::vector<language_filet *> files;
   for(const auto &arg : _cmdline.args)
   {
-    if(parse(arg))
+    language_filet *lf = add_file(arg);
+    if(lf == nullptr)
       return true;
+
+    if(std::find(files.begin(), files.end(), lf) == files.end())
+      files.push_back(lf);
+  }
+
+  unsigned int num_threads = 0;
+  if(_cmdline.isset("parse-threads"))
+    num_threads = strtoul(_cmdline.getval("parse-threads"), nullptr, 10);
+  else
+    num_threads = std::thread::hardware_concurrency();
+
+  for(language_filet *lf : files)
+    if(!lf->language->parse_is_thread_safe())
+      num_threads = 1;
+
+  num_threads = std::min<std::size_t>(std::max(num_threads, 1u), files.size());
+
+  // Each worker takes the next unparsed file until none are left. Only the
+  // parsing itself runs here: nothing else about a file is touched until all
+  // the workers are done.
+  std::vector<char> failed(files.size(), false);
+  std::atomic<std::size_t> next(0);
+  auto worker = [&]() {
+    for(std::size_t i = next++; i < files.size(); i = next++)
+      failed[i] = files[i]->language->parse(
+        files[i]->filename, *get_message_handler());
+  };
+
+  if(num_threads > 1)
+  {
+    status("Parsing " + i2string(files.size()) + " files with " +
+           i2string(num_threads) + " threads");
+
+    // Report the files up front, in order, as the serial path does; the
+    // workers themselves stay quiet so their output can't interleave.
+    for(language_filet *lf : files)
+      status("Parsing", lf->filename);
+
+    std::vector<std::thread> workers;
+    for(unsigned int i = 0; i < num_threads; i++)
+      workers.emplace_back(worker);
+    for(std::thread &t : workers)
+      t.join();
+  }
+  else
+  {
+    for(std::size_t i = 0; i < files.size(); i++)
+    {
+      status("Parsing", files[i]->filename);
+      failed[i] =
+        files[i]->language->parse(files[i]->filename, *get_message_handler());
+      if(failed[i])
+        break;
+    }
+  }
+
+  for(std::size_t i = 0; i < files.size(); i++)
+  {
+    if(failed[i])
+    {
+      if(get_ui() == ui_message_handlert::PLAIN)
+        std::cerr << "PARSING ERROR" << std::endl;
+
+      return true;
+    }
+
+    files[i]->get_modules();
   }
 
   return false;
 }
 
-bool language_uit::parse(const std::string &filename)
+language_filet *language_uit::add_file(const std::string &filename)
 {
   int mode = get_mode_filename(filename);
 
   if(mode < 0)
   {
     error("failed to figure out type of file", filename);
-    return true;
+    return nullptr;
   }
 
   if(config.options.get_bool_option("old-frontend"))
@@ -60,23 +135,32 @@ bool language_uit::parse(const std::string &filename)
   if(!infile)
   {
     error("failed to open input file", filename);
-    return true;
+    return nullptr;
   }
 
-  language_filet language_file;
-
   std::pair<language_filest::filemapt::iterator, bool> result =
     language_files.filemap.insert(
-      std::pair<std::string, language_filet>(filename, language_file));
+      std::pair<std::string, language_filet>(filename, language_filet()));
 
   language_filet &lf = result.first->second;
-  lf.filename = filename;
-  lf.language = mode_table[mode].new_language();
-  languaget &language = *lf.language;
+  if(result.second)
+  {
+    lf.filename = filename;
+    lf.language = mode_table[mode].new_language();
+  }
+
+  return &lf;
+}
+
+bool language_uit::parse(const std::string &filename)
+{
+  language_filet *lf = add_file(filename);
+  if(lf == nullptr)
+    return true;
 
   status("Parsing", filename);
 
-  if(language.parse(filename, *get_message_handler()))
+  if(lf->language->parse(filename, *get_message_handler()))
   {
     if(get_ui() == ui_message_handlert::PLAIN)
       std::cerr << "PARSING ERROR" << std::endl;
@@ -84,7 +168,7 @@ bool language_uit::parse(const std::string &filename)
     return true;
   }
 
-  lf.get_modules();
+  lf->get_modules();
 
   return false;
 }
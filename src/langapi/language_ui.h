@@ -49,6 +49,11 @@ public:
 
 protected:
   const cmdlinet &_cmdline;
+
+  /** Find or create the language_filet for a file, without parsing it.
+   *  @return nullptr if the file can't be opened or its language is
+   *          unknown. */
+  language_filet *add_file(const std::string &filename);
 };
 
 #endif
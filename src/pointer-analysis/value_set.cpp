@@ -35,7 +35,7 @@ void value_sett::output(std::ostream &out) const
   {
     std::string identifier, display_name;
 
-    const entryt &e = value.second;
+    const entryt &e = *value.second;
 
     if(has_prefix(e.identifier, "value_set::dynamic_object"))
     {
@@ -131,13 +131,18 @@ expr2tc value_sett::to_expr(object_mapt::const_iterator it) const
 
 bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
 {
+  // Merging a value set into one it was copied from, with neither written
+  // to since, changes nothing.
+  if(values.shares(new_values))
+    return false;
+
   bool result = false;
 
   // Iterate over all new values; if they're in the current value set, merge
   // them. If not, only merge it in if keepnew is true.
   for(const auto &new_value : new_values)
   {
-    valuest::iterator it2 = values.find(new_value.first);
+    valuest::const_iterator it2 = values.find(new_value.first);
 
     // If the new variable isnt in this' set,
     if(it2 == values.end())
@@ -146,21 +151,23 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
       // that's transfered back and forth between function calls. So, the
       // variables not existing in the state we're merging into is irrelevant.
       if(
-        has_prefix(
-          id2string(new_value.second.identifier),
-          "value_set::dynamic_object") ||
-        new_value.second.identifier == "value_set::return_value" || keepnew)
+        has_prefix(new_value.second->identifier, "value_set::dynamic_object") ||
+        new_value.second->identifier == "value_set::return_value" || keepnew)
       {
-        values.insert(new_value);
+        values.insert(new_value.first, new_value.second);
         result = true;
       }
 
       continue;
     }
 
+    // Both sides still share this entry: nothing to merge.
+    if(it2->second == new_value.second)
+      continue;
+
     // The variable was in this' set, merge the values.
-    entryt &e = it2->second;
-    const entryt &new_e = new_value.second;
+    const entryt &new_e = *new_value.second;
+    entryt &e = values.write(new_value.first, new_e);
 
     if(make_union(e.object_map, new_e.object_map))
       result = true;
@@ -423,14 +430,14 @@ void value_sett::get_value_set_rec(
     assert(is_constant_int2t(dyn.instance));
     const constant_int2t &intref = to_constant_int2t(dyn.instance);
     std::string idnum = integer2string(intref.value);
-    const std::string name = "value_set::dynamic_object" + idnum + suffix;
+    const std::string name = "value_set::dynamic_object" + idnum;
 
     // look it up
-    valuest::const_iterator v_it = values.find(name);
+    valuest::const_iterator v_it = values.find(entry_key(name, suffix));
 
     if(v_it != values.end())
     {
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, v_it->second->object_map);
       return;
     }
   }
@@ -490,12 +497,13 @@ void value_sett::get_value_set_rec(
 
     // Look up this symbol, with the given suffix to distinguish any arrays or
     // members we've picked out of it at a higher level.
-    valuest::const_iterator v_it = values.find(sym.get_symbol_name() + suffix);
+    valuest::const_iterator v_it =
+      values.find(entry_key(sym.get_symbol_name(), suffix));
 
     // If it points at things, put those things into the destination object map.
     if(v_it != values.end())
     {
-      make_union(dest, v_it->second.object_map);
+      make_union(dest, v_it->second->object_map);
       return;
     }
   }
@@ -1070,15 +1078,18 @@ void value_sett::do_free(const expr2tc &op)
   }
 
   // mark these as 'may be invalid'
-  // this, unfortunately, destroys the sharing
-  for(auto &value : values)
+  // Entries are only detached once we know they change, after the walk, so
+  // that the ones left alone stay shared.
+  std::vector<std::pair<entry_keyt, object_mapt>> marked;
+
+  for(const auto &value : values)
   {
     object_mapt new_object_map;
 
     bool changed = false;
 
-    for(object_mapt::const_iterator o_it = value.second.object_map.begin();
-        o_it != value.second.object_map.end();
+    for(object_mapt::const_iterator o_it = value.second->object_map.begin();
+        o_it != value.second->object_map.end();
         o_it++)
     {
       const expr2tc &object = object_numbering[o_it->first];
@@ -1105,7 +1116,13 @@ void value_sett::do_free(const expr2tc &op)
     }
 
     if(changed)
-      value.second.object_map = new_object_map;
+      marked.emplace_back(value.first, std::move(new_object_map));
+  }
+
+  for(auto &m : marked)
+  {
+    valuest::const_iterator it = values.find(m.first);
+    values.write(m.first, *it->second).object_map.swap(m.second);
   }
 }
 
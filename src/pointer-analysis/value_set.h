@@ -9,6 +9,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 #define CPROVER_POINTER_ANALYSIS_VALUE_SET_H
 
+#include <cstdint>
+#include <memory>
 #include <pointer-analysis/value_sets.h>
 #include <set>
 #include <util/irep2.h>
@@ -250,10 +252,104 @@ public:
     }
   };
 
+  /** Key of an entryt in value_sett::values: the string numbers of its
+   *  identifier and suffix, rather than the concatenation of the two. */
+  typedef uint64_t entry_keyt;
+
+  static entry_keyt
+  entry_key(const std::string &identifier, const std::string &suffix)
+  {
+    return (entry_keyt(irep_idt(identifier).get_no()) << 32) |
+           irep_idt(suffix).get_no();
+  }
+
   /** Type of the value-set containing structure. A hash map mapping variables
    *  to an entryt, storing the value set of objects a variable might point
-   *  at. */
-  typedef std::unordered_map<irep_idt, entryt, irep_id_hash> valuest;
+   *  at.
+   *
+   *  Symex copies the whole value set at every branch, and most of it is
+   *  never written again before the copies get merged back. So both the map
+   *  and the entries in it are copy-on-write: copies share them until one
+   *  side writes, taking a snapshot costs a reference count, and a merge
+   *  can skip any entry the two sides still share. Only the non-const
+   *  accessors detach. */
+  class valuest
+  {
+  public:
+    typedef std::unordered_map<entry_keyt, std::shared_ptr<entryt>> mapt;
+    typedef mapt::const_iterator const_iterator;
+
+    valuest() : themap(std::make_shared<mapt>())
+    {
+    }
+
+    const_iterator begin() const
+    {
+      return themap->begin();
+    }
+
+    const_iterator end() const
+    {
+      return themap->end();
+    }
+
+    const_iterator find(entry_keyt key) const
+    {
+      return themap->find(key);
+    }
+
+    std::size_t size() const
+    {
+      return themap->size();
+    }
+
+    /** True if this and ref still share all of their storage. */
+    bool shares(const valuest &ref) const
+    {
+      return themap == ref.themap;
+    }
+
+    /** Writable access to the entry under key, which is created as a copy
+     *  of init if there is none. */
+    entryt &write(entry_keyt key, const entryt &init)
+    {
+      std::shared_ptr<entryt> &e = detach()[key];
+      if(!e)
+        e = std::make_shared<entryt>(init);
+      else if(e.use_count() > 1)
+        e = std::make_shared<entryt>(*e);
+      return *e;
+    }
+
+    /** Add an entry that is shared with another valuest. */
+    void insert(entry_keyt key, const std::shared_ptr<entryt> &e)
+    {
+      detach().emplace(key, e);
+    }
+
+    bool erase(entry_keyt key)
+    {
+      if(themap->find(key) == themap->end())
+        return false;
+      detach().erase(key);
+      return true;
+    }
+
+    void clear()
+    {
+      themap = std::make_shared<mapt>();
+    }
+
+  protected:
+    std::shared_ptr<mapt> themap;
+
+    mapt &detach()
+    {
+      if(themap.use_count() > 1)
+        themap = std::make_shared<mapt>(*themap);
+      return *themap;
+    }
+  };
 
   /** Get the natural alignment unit of a reference to e. I don't know a more
    *  appropriate term, but if we were to have an offset into e, then what is
@@ -415,11 +511,11 @@ public:
   }
 
   /** Remove the given pointer value set from the map.
-   *  @param name The name of the variable, including suffix, to erase.
+   *  @param name The name of the variable, with no suffix, to erase.
    *  @return True when the erase succeeds, false otherwise. */
   bool erase(const std::string &name)
   {
-    return (values.erase(name) == 1);
+    return values.erase(entry_key(name, ""));
   }
 
   /** Get the set of things that an expression might point at. Interprets the
@@ -454,19 +550,20 @@ public:
    *  given record already exists. */
   void add_var(const std::string &id, const std::string &suffix)
   {
-    get_entry(id, suffix);
+    add_var(entryt(id, suffix));
   }
 
   void add_var(const entryt &e)
   {
-    get_entry(e.identifier, e.suffix);
+    // Don't detach an existing entry just to find it is already there.
+    if(values.find(entry_key(e.identifier, e.suffix)) == values.end())
+      get_entry(e);
   }
 
   /** Delete the value set for the given variable name and suffix. */
   void del_var(const std::string &id, const std::string &suffix)
   {
-    std::string index = id2string(id) + suffix;
-    values.erase(index);
+    values.erase(entry_key(id, suffix));
   }
 
   /** Look up the value set for the given variable name and suffix. */
@@ -479,12 +576,7 @@ public:
    *  given entryt. */
   entryt &get_entry(const entryt &e)
   {
-    std::string index = id2string(e.identifier) + e.suffix;
-
-    std::pair<valuest::iterator, bool> r =
-      values.insert(std::pair<irep_idt, entryt>(index, e));
-
-    return r.first->second;
+    return values.write(entry_key(e.identifier, e.suffix), e);
   }
 
   /** Add a value set for each variable in the given list. */
@@ -657,7 +749,7 @@ public:
   static object_number_numberingt obj_numbering_refset;
 
   /** Storage for all the value sets for all the variables in the program. See
-   *  @ref entryt for the format of the string used as an index. */
+   *  @ref entry_key for the index. */
   valuest values;
 
   /** Namespace for looking up types against. */
@@ -6,11 +6,12 @@
 smt_convt *create_new_cvc_solver(
   bool int_encoding,
   const namespacet &ns,
-  tuple_iface **tuple_api [[gnu::unused]],
+  tuple_iface **tuple_api,
   array_iface **array_api,
   fp_convt **fp_api)
 {
   cvc_convt *conv = new cvc_convt(int_encoding, ns);
+  *tuple_api = static_cast<tuple_iface *>(conv);
   *array_api = static_cast<array_iface *>(conv);
   *fp_api = static_cast<fp_convt *>(conv);
   return conv;
@@ -99,6 +100,35 @@ expr2tc cvc_convt::get_array_elem(
   return get_by_ast(subtype, new_ast(e, convert_sort(subtype)));
 }
 
+CVC4::Expr cvc_convt::mk_tuple_update(
+  const CVC4::Expr &t,
+  unsigned i,
+  const CVC4::Expr &newval)
+{
+  // Datatypes have no update operator: rebuild the tuple from the selected
+  // fields, swapping in the new value.
+  const CVC4::Datatype &dt =
+    static_cast<CVC4::DatatypeType>(t.getType()).getDatatype();
+  const CVC4::DatatypeConstructor &cons = dt[0];
+  assert(i < cons.getNumArgs() && "Invalid tuple update, index too large");
+
+  std::vector<CVC4::Expr> args;
+  for(unsigned j = 0; j < cons.getNumArgs(); ++j)
+    args.push_back(j == i ? newval : mk_tuple_select(t, j));
+
+  return em.mkExpr(CVC4::kind::APPLY_CONSTRUCTOR, cons.getConstructor(), args);
+}
+
+CVC4::Expr cvc_convt::mk_tuple_select(const CVC4::Expr &t, unsigned i)
+{
+  const CVC4::Datatype &dt =
+    static_cast<CVC4::DatatypeType>(t.getType()).getDatatype();
+  const CVC4::DatatypeConstructor &cons = dt[0];
+  assert(i < cons.getNumArgs() && "Invalid tuple select, index too large");
+
+  return em.mkExpr(CVC4::kind::APPLY_SELECTOR, cons[i].getSelector(), t);
+}
+
 const std::string cvc_convt::solver_text()
 {
   std::stringstream ss;
@@ -1266,6 +1296,170 @@ smt_sortt cvc_convt::mk_fpbv_rm_sort()
     SMT_SORT_FPBV_RM, em.roundingModeType(), 3);
 }
 
+smt_sortt cvc_convt::mk_struct_sort(const type2tc &type)
+{
+  if(is_array_type(type))
+  {
+    const array_type2t &arrtype = to_array_type(type);
+    smt_sortt subtypesort = convert_sort(arrtype.subtype);
+    smt_sortt d = mk_int_bv_sort(make_array_domain_type(arrtype)->get_width());
+    return mk_array_sort(d, subtypesort);
+  }
+
+  auto it = struct_types.find(type);
+  if(it != struct_types.end())
+    return new solver_smt_sort<CVC4::Type>(SMT_SORT_STRUCT, it->second, type);
+
+  const struct_type2t &strct = to_struct_type(type);
+  std::string name = "struct_type_" + strct.name.as_string();
+
+  CVC4::Datatype dt(&em, name);
+  CVC4::DatatypeConstructor cons("mk_" + name);
+  for(std::size_t i = 0; i < strct.members.size(); ++i)
+    cons.addArg(
+      strct.member_names[i].as_string(),
+      to_solver_smt_sort<CVC4::Type>(convert_sort(strct.members[i]))->s);
+  dt.addConstructor(cons);
+
+  CVC4::DatatypeType t = em.mkDatatypeType(dt);
+  struct_types.emplace(type, t);
+  return new solver_smt_sort<CVC4::Type>(SMT_SORT_STRUCT, t, type);
+}
+
+smt_astt cvc_smt_ast::update(
+  smt_convt *conv,
+  smt_astt value,
+  unsigned int idx,
+  expr2tc idx_expr) const
+{
+  if(sort->id == SMT_SORT_ARRAY)
+    return smt_ast::update(conv, value, idx, idx_expr);
+
+  assert(sort->id == SMT_SORT_STRUCT);
+  assert(is_nil_expr(idx_expr) && "Can only update constant index tuple elems");
+
+  cvc_convt *cvc_conv = static_cast<cvc_convt *>(conv);
+  const cvc_smt_ast *updateval = to_solver_smt_ast<cvc_smt_ast>(value);
+  return cvc_conv->new_ast(
+    cvc_conv->mk_tuple_update(a, idx, updateval->a), sort);
+}
+
+smt_astt cvc_smt_ast::project(smt_convt *conv, unsigned int elem) const
+{
+  cvc_convt *cvc_conv = static_cast<cvc_convt *>(conv);
+
+  assert(!is_nil_type(sort->get_tuple_type()));
+  const struct_union_data &data = conv->get_type_def(sort->get_tuple_type());
+
+  assert(elem < data.members.size());
+  const smt_sort *idx_sort = conv->convert_sort(data.members[elem]);
+
+  return cvc_conv->new_ast(cvc_conv->mk_tuple_select(a, elem), idx_sort);
+}
+
+smt_astt cvc_convt::tuple_create(const expr2tc &structdef)
+{
+  const constant_struct2t &strct = to_constant_struct2t(structdef);
+  smt_sortt s = mk_struct_sort(structdef->type);
+
+  std::vector<CVC4::Expr> args;
+  for(auto const &m : strct.datatype_members)
+    args.push_back(to_solver_smt_ast<cvc_smt_ast>(convert_ast(m))->a);
+
+  const CVC4::Datatype &dt =
+    static_cast<CVC4::DatatypeType>(to_solver_smt_sort<CVC4::Type>(s)->s)
+      .getDatatype();
+  return new_ast(
+    em.mkExpr(CVC4::kind::APPLY_CONSTRUCTOR, dt[0].getConstructor(), args), s);
+}
+
+smt_astt cvc_convt::tuple_fresh(const smt_sort *s, std::string name)
+{
+  if(name == "")
+    return mk_fresh(s, "cvc_convt::tuple_fresh");
+
+  return mk_smt_symbol(name, s);
+}
+
+smt_astt cvc_convt::tuple_array_create(
+  const type2tc &arr_type,
+  smt_astt *input_args,
+  bool const_array,
+  const smt_sort *domain)
+{
+  const array_type2t &arrtype = to_array_type(arr_type);
+  smt_sortt ssort = mk_struct_sort(arrtype.subtype);
+  smt_sortt asort = mk_array_sort(domain, ssort);
+
+  if(const_array)
+    return convert_array_of(*input_args, domain->get_data_width());
+
+  assert(
+    is_constant_int2t(arrtype.array_size) &&
+    "array_of sizes should be constant");
+
+  smt_astt output = mk_fresh(asort, "cvc_convt::tuple_array_create");
+  uint64_t size = to_constant_int2t(arrtype.array_size).as_ulong();
+  for(uint64_t i = 0; i < size; ++i)
+  {
+    smt_astt idx =
+      int_encoding ? mk_smt_int(BigInt(i)) : mk_smt_bv(BigInt(i), domain);
+    output = mk_store(output, idx, input_args[i]);
+  }
+
+  return output;
+}
+
+smt_astt cvc_convt::mk_tuple_symbol(const std::string &name, smt_sortt s)
+{
+  return mk_smt_symbol(name, s);
+}
+
+smt_astt cvc_convt::mk_tuple_array_symbol(const expr2tc &expr)
+{
+  const symbol2t &sym = to_symbol2t(expr);
+  return mk_smt_symbol(sym.get_symbol_name(), convert_sort(sym.type));
+}
+
+smt_astt
+cvc_convt::tuple_array_of(const expr2tc &init, unsigned long domain_width)
+{
+  return convert_array_of(convert_ast(init), domain_width);
+}
+
+expr2tc cvc_convt::tuple_get(const expr2tc &expr)
+{
+  const struct_union_data &strct = get_type_def(expr->type);
+
+  if(is_pointer_type(expr->type))
+  {
+    // Pointers are an object number and an offset; read both back and let
+    // the pointer logic rebuild the pointer expression.
+    smt_astt sym = convert_ast(expr);
+    smt_astt object = sym->project(this, 0);
+    smt_astt offset = sym->project(this, 1);
+
+    unsigned int num =
+      get_bv(object, is_signedbv_type(strct.members[0])).to_uint64();
+    unsigned int offs =
+      get_bv(offset, is_signedbv_type(strct.members[1])).to_uint64();
+    pointer_logict::pointert p(num, BigInt(offs));
+    return pointer_logic.back().pointer_expr(p, expr->type);
+  }
+
+  // Otherwise, run through all fields and despatch to 'get' again.
+  constant_struct2tc outstruct(expr->type, std::vector<expr2tc>());
+  unsigned int i = 0;
+  for(auto const &it : strct.members)
+  {
+    member2tc memb(it, expr, strct.member_names[i]);
+    outstruct->datatype_members.push_back(get(memb));
+    i++;
+  }
+
+  return outstruct;
+}
+
 void cvc_convt::dump_smt()
 {
   auto const &assertions = smt.getAssertions();
@@ -1,6 +1,7 @@
 #ifndef _ESBMC_SOLVERS_CVC_CVC_CONV_H_
 #define _ESBMC_SOLVERS_CVC_CVC_CONV_H_
 
+#include <unordered_map>
 #include <solvers/smt/smt_conv.h>
 #include <cvc4/cvc4.h>
 
@@ -9,10 +10,20 @@ class cvc_smt_ast : public solver_smt_ast<CVC4::Expr>
 public:
   using solver_smt_ast<CVC4::Expr>::solver_smt_ast;
   ~cvc_smt_ast() override = default;
+
+  smt_astt
+  update(smt_convt *ctx, smt_astt value, unsigned int idx, expr2tc idx_expr)
+    const override;
+
+  smt_astt project(smt_convt *ctx, unsigned int elem) const override;
+
   void dump() const override;
 };
 
-class cvc_convt : public smt_convt, public array_iface, public fp_convt
+class cvc_convt : public smt_convt,
+                  public tuple_iface,
+                  public array_iface,
+                  public fp_convt
 {
 public:
   cvc_convt(bool int_encoding, const namespacet &ns);
@@ -27,6 +38,10 @@ public:
   expr2tc get_array_elem(smt_astt array, uint64_t index, const type2tc &subtype)
     override;
 
+  CVC4::Expr
+  mk_tuple_update(const CVC4::Expr &t, unsigned i, const CVC4::Expr &new_val);
+  CVC4::Expr mk_tuple_select(const CVC4::Expr &t, unsigned i);
+
   // SMT-abstraction migration:
   smt_astt mk_add(smt_astt a, smt_astt b) override;
   smt_astt mk_bvadd(smt_astt a, smt_astt b) override;
@@ -148,6 +163,22 @@ public:
   smt_astt
   convert_array_of(smt_astt init_val, unsigned long domain_width) override;
 
+  // Structs are CVC4 datatypes with a single constructor, one selector per
+  // member, rather than being flattened into a symbol per field.
+  smt_sortt mk_struct_sort(const type2tc &type) override;
+  smt_astt tuple_create(const expr2tc &structdef) override;
+  smt_astt tuple_fresh(const smt_sort *s, std::string name = "") override;
+  expr2tc tuple_get(const expr2tc &expr) override;
+  smt_astt tuple_array_create(
+    const type2tc &array_type,
+    smt_astt *inputargs,
+    bool const_array,
+    const smt_sort *domain) override;
+  smt_astt mk_tuple_symbol(const std::string &name, smt_sortt s) override;
+  smt_astt mk_tuple_array_symbol(const expr2tc &expr) override;
+  smt_astt
+  tuple_array_of(const expr2tc &init, unsigned long domain_width) override;
+
   void assert_ast(smt_astt a) override;
 
   void dump_smt() override;
@@ -157,6 +188,11 @@ public:
   CVC4::ExprManager em;
   CVC4::SmtEngine smt;
   CVC4::SymbolTable sym_tab;
+
+  // CVC4 creates a distinct type each time a datatype is declared, so every
+  // struct is declared exactly once and its type reused from here. Declared
+  // after em, so that these go before it does.
+  std::unordered_map<type2tc, CVC4::DatatypeType, type2_hash> struct_types;
 };
 
 #endif /* _ESBMC_SOLVERS_CVC_CVC_CONV_H_ */
@@ -127,6 +127,10 @@ public:
 
   void push_ctx() override;
   void pop_ctx() override;
+  bool can_pop_assertions() const override
+  {
+    return true;
+  }
 
   bool get_bool(smt_astt a) override;
   BigInt get_bv(smt_astt a, bool is_signed) override;
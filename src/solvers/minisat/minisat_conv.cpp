@@ -1,18 +1,27 @@
-#include <set>
-#include <sstream>
-#include <util/c_types.h>
 #include <minisat_conv.h>
 
 smt_convt *create_new_minisat_solver(
   bool int_encoding,
   const namespacet &ns,
-  const optionst &options,
   tuple_iface **tuple_api [[gnu::unused]],
   array_iface **array_api [[gnu::unused]],
-  fp_iface **fp_api [[gnu::unused]])
+  fp_convt **fp_api [[gnu::unused]])
 {
-  minisat_convt *conv = new minisat_convt(int_encoding, ns, options);
-  return conv;
+  // Arrays, tuples and floats all go through the default flatteners.
+  return new minisat_convt(int_encoding, ns);
+}
+
+minisat_convt::minisat_convt(bool int_encoding, const namespacet &_ns)
+  : cnf_iface(),
+    cnf_convt(static_cast<cnf_iface *>(this)),
+    bitblast_convt(int_encoding, _ns, static_cast<sat_iface *>(this)),
+    false_asserted(false)
+{
+  if(int_encoding)
+  {
+    std::cerr << "MiniSAT does not support integer encoding mode" << std::endl;
+    abort();
+  }
 }
 
 literalt minisat_convt::new_variable()
@@ -27,26 +36,16 @@ void minisat_convt::convert(const bvt &bv, Minisat::vec<Lit> &dest)
 {
   dest.capacity(bv.size());
 
-  for(unsigned int i = 0; i < bv.size(); i++)
+  for(const literalt &l : bv)
   {
-    if(!bv[i].is_false())
-      dest.push(Minisat::mkLit(bv[i].var_no(), bv[i].sign()));
+    if(!l.is_false())
+      dest.push(convert(l));
   }
-  return;
 }
 
 void minisat_convt::setto(literalt a, bool val)
 {
-  bvt b;
-  if(val)
-    b.push_back(a);
-  else
-    b.push_back(cnf_convt::lnot(a));
-
-  Minisat::vec<Lit> l;
-  convert(b, l);
-  solver.addClause_(l);
-  return;
+  lcnf(bvt(1, val ? a : cnf_convt::lnot(a)));
 }
 
 void minisat_convt::lcnf(const bvt &bv)
@@ -57,29 +56,48 @@ void minisat_convt::lcnf(const bvt &bv)
     return;
 
   if(new_bv.empty())
+  {
+    // Every literal was false: this clause can never be satisfied.
+    false_asserted = true;
     return;
+  }
 
   Minisat::vec<Lit> c;
-  convert(bv, c);
+  convert(new_bv, c);
   solver.addClause_(c);
-  return;
 }
 
-minisat_convt::minisat_convt(
-  bool int_encoding,
-  const namespacet &_ns,
-  const optionst &_opts)
-  : cnf_iface(),
-    cnf_convt(static_cast<cnf_iface *>(this)),
-    bitblast_convt(int_encoding, _ns, static_cast<sat_iface *>(this)),
-    solver(),
-    options(_opts),
-    false_asserted(false)
+void minisat_convt::assert_lit(const literalt &l)
+{
+  if(activation_lits.empty())
+  {
+    lcnf(bvt(1, l));
+    return;
+  }
+
+  // Only holds while the innermost context is live.
+  bvt clause;
+  clause.push_back(cnf_convt::lnot(activation_lits.back()));
+  clause.push_back(l);
+  lcnf(clause);
+}
+
+void minisat_convt::push_ctx()
 {
+  smt_convt::push_ctx();
+
+  // Clauses are only guarded by the innermost literal, so dec_solve has to
+  // assume every live one.
+  activation_lits.push_back(new_variable());
 }
 
-minisat_convt::~minisat_convt(void)
+void minisat_convt::pop_ctx()
 {
+  assert(!activation_lits.empty());
+  setto(activation_lits.back(), false);
+  activation_lits.pop_back();
+
+  smt_convt::pop_ctx();
 }
 
 smt_convt::resultt minisat_convt::dec_solve()
@@ -90,27 +108,13 @@ smt_convt::resultt minisat_convt::dec_solve()
     // Then the formula can never be satisfied.
     return smt_convt::P_UNSATISFIABLE;
 
-  bool res = solver.solve();
-  if(res)
-    return smt_convt::P_SATISFIABLE;
-  else
-    return smt_convt::P_UNSATISFIABLE;
-}
+  Minisat::vec<Lit> assumptions;
+  convert(activation_lits, assumptions);
 
-void minisat_convt::dump_bv(const bvt &bv) const
-{
-  for(unsigned int i = 0; i < bv.size(); i++)
-  {
-    if(bv[i] == const_literal(false))
-      std::cerr << "0";
-    else if(bv[i] == const_literal(true))
-      std::cerr << "1";
-    else
-      std::cerr << "?";
-  }
+  if(solver.solve(assumptions))
+    return smt_convt::P_SATISFIABLE;
 
-  std::cerr << " " << bv.size() << std::endl;
-  return;
+  return smt_convt::P_UNSATISFIABLE;
 }
 
 const std::string minisat_convt::solver_text()
@@ -120,34 +124,17 @@ const std::string minisat_convt::solver_text()
 
 tvt minisat_convt::l_get(const literalt &l)
 {
-  if(l == const_literal(true))
+  if(l.is_true())
     return tvt(tvt::TV_TRUE);
-  else if(l == const_literal(false))
+  if(l.is_false())
     return tvt(tvt::TV_FALSE);
 
-  Minisat::lbool val = solver.modelValue(Minisat::mkLit(l.var_no(), l.sign()));
+  Minisat::lbool val = solver.modelValue(convert(l));
   int v = Minisat::toInt(val);
   if(v == 0)
     return tvt(tvt::TV_TRUE);
-  else if(v == 1)
+  if(v == 1)
     return tvt(tvt::TV_FALSE);
-  else
-    return tvt(tvt::TV_UNKNOWN);
-}
 
-void minisat_convt::assert_lit(const literalt &l)
-{
-  if(l.is_true())
-    return;
-
-  if(l.is_false())
-  {
-    false_asserted = true;
-    return;
-  }
-
-  Minisat::vec<Lit> c;
-  c.push(Minisat::mkLit(l.var_no(), l.sign()));
-  solver.addClause_(c);
-  return;
+  return tvt(tvt::TV_UNKNOWN);
 }
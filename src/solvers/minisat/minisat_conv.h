@@ -1,5 +1,5 @@
-#ifndef _ESBMC_SOLVERS_SMTLIB_CONV_H_
-#define _ESBMC_SOLVERS_SMTLIB_CONV_H_
+#ifndef _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_
+#define _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_
 
 // For the sake of...
 #define __STDC_LIMIT_MACROS
@@ -9,49 +9,58 @@
 #include <stdint.h>
 #include <inttypes.h>
 #include <solvers/smt/smt_conv.h>
-#include <solvers/smt/smt_tuple_flat.h>
-#include <solvers/smt/array_conv.h>
 #include <solvers/sat/bitblast_conv.h>
 #include <solvers/sat/cnf_conv.h>
-#include <core/Solver.h>
+#include <minisat/core/Solver.h>
 
 typedef Minisat::Lit Lit;
-typedef Minisat::lbool lbool;
-typedef std::vector<literalt> bvt;
 
 class minisat_convt : public cnf_iface, public cnf_convt, public bitblast_convt
 {
 public:
-  typedef enum
-  {
-    LEFT,
-    LRIGHT,
-    ARIGHT
-  } shiftt;
-
-  minisat_convt(bool int_encoding, const namespacet &_ns, const optionst &opts);
-  ~minisat_convt();
+  minisat_convt(bool int_encoding, const namespacet &_ns);
+  ~minisat_convt() override = default;
 
   // Things definitely to be done by the solver:
-  virtual resultt dec_solve();
-  virtual const std::string solver_text();
-  virtual tvt l_get(const literalt &a);
-  virtual literalt new_variable();
-  virtual void assert_lit(const literalt &l);
-  virtual void lcnf(const bvt &bv);
+  resultt dec_solve() override;
+  const std::string solver_text() override;
+  tvt l_get(const literalt &a) override;
+  literalt new_variable() override;
+  void assert_lit(const literalt &l) override;
+  void lcnf(const bvt &bv) override;
+  void setto(literalt a, bool val) override;
+
+  // Contexts are implemented with activation literals: everything asserted
+  // while a context is live is guarded by its literal, which dec_solve then
+  // assumes. Popping asserts the negation, retiring the context's clauses
+  // without restarting the solver or losing what it has learnt.
+  void push_ctx() override;
+  void pop_ctx() override;
+  bool can_pop_assertions() const override
+  {
+    return true;
+  }
 
-  virtual void setto(literalt a, bool val);
+  using bitblast_convt::l_get;
 
   // Internal gunk
 
+  Lit convert(literalt l) const
+  {
+    return Minisat::mkLit(l.var_no(), l.sign());
+  }
   void convert(const bvt &bv, Minisat::vec<Lit> &dest);
-  void dump_bv(const bvt &bv) const;
 
   // Members
 
   Minisat::Solver solver;
-  const optionst &options;
+
+  /** One activation literal per live context, innermost last. */
+  bvt activation_lits;
+
+  /** Set once false is asserted outside any context; the formula can then
+   *  never be satisfied. */
   bool false_asserted;
 };
 
-#endif /* _ESBMC_SOLVERS_SMTLIB_CONV_H_ */
+#endif /* _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_ */
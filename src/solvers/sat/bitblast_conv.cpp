@@ -1,5 +1,6 @@
 #include <set>
 #include <bitblast_conv.h>
+#include <util/mp_arith.h>
 
 bitblast_convt::bitblast_convt(
   bool int_encoding,
@@ -9,483 +10,399 @@ bitblast_convt::bitblast_convt(
 {
 }
 
-bitblast_convt::~bitblast_convt()
+void bitblast_smt_ast::dump() const
 {
+  std::cout << "bitblast ast, " << a.size() << " literals:";
+  for(literalt l : a)
+  {
+    if(l.is_constant())
+      std::cout << " " << (l.is_true() ? "1" : "0");
+    else
+      std::cout << " " << (l.sign() ? "-" : "") << l.var_no();
+  }
+  std::cout << "\n";
 }
 
 void bitblast_convt::assert_ast(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_BOOL);
-  const bitblast_smt_ast *ba = bitblast_ast_downcast(a);
-  sat_api->assert_lit(ba->bv[0]);
-  return;
+  sat_api->assert_lit(get_bv_lits(a)[0]);
 }
 
-smt_astt bitblast_convt::mk_func_app(
-  smt_sortt ressort,
-  smt_func_kind f,
-  const smt_ast *const *_args,
-  unsigned int numargs)
+smt_astt bitblast_convt::mk_bvadd(smt_astt a, smt_astt b)
 {
-  const bitblast_smt_ast *args[4];
-  bitblast_smt_ast *result = NULL;
-  unsigned int i;
+  bvt res;
+  literalt carry_out;
+  full_adder(
+    get_bv_lits(a), get_bv_lits(b), res, const_literal(false), carry_out);
+  return new_ast(res, a->sort);
+}
 
-  assert(numargs < 4 && "Too many arguments to bitblast_convt::mk_func_app");
-  for(i = 0; i < numargs; i++)
-    args[i] = bitblast_ast_downcast(_args[i]);
+smt_astt bitblast_convt::mk_bvsub(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvt op1 = get_bv_lits(b);
+  invert(op1);
+  literalt carry_out;
+  full_adder(get_bv_lits(a), op1, res, const_literal(true), carry_out);
+  return new_ast(res, a->sort);
+}
 
-  switch(f)
-  {
-  case SMT_FUNC_EQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    break;
-  }
-  case SMT_FUNC_NOTEQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    result->bv[0] = sat_api->lnot(result->bv[0]);
-    break;
-  }
-  case SMT_FUNC_NOT:
-  {
-    literalt res = sat_api->lnot(args[0]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_OR:
-  {
-    literalt res = sat_api->lor(args[0]->bv[0], args[1]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_IMPLIES:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->limplies(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_ITE:
-  {
-    if(ressort->id == SMT_SORT_ARRAY)
-    {
-      return _args[1]->ite(this, _args[0], _args[2]);
-    }
-    else
-    {
-      assert(args[1]->bv.size() == args[2]->bv.size());
-      result = new_ast(ressort);
-      for(unsigned int i = 0; i < args[1]->bv.size(); i++)
-        result->bv.push_back(
-          sat_api->lselect(args[0]->bv[0], args[1]->bv[i], args[2]->bv[i]));
-    }
-    break;
-  }
-  case SMT_FUNC_AND:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->land(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_XOR:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->lxor(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_BVADD:
-  {
-    literalt carry_in = const_literal(false);
-    literalt carry_out;
-    result = new_ast(ressort);
-    full_adder(args[0]->bv, args[1]->bv, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVSUB:
-  {
-    literalt carry_in = const_literal(true);
-    literalt carry_out;
-    result = new_ast(ressort);
-    bvt op1 = args[1]->bv;
-    invert(op1);
-    full_adder(args[0]->bv, op1, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVUGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVULT, args2, 2);
-  }
-  case SMT_FUNC_BVUGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVULT, _args, 2);
-    a = mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-    return a;
-  }
-  case SMT_FUNC_BVULT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(unsigned_less_than(args[0]->bv, args[1]->bv));
-    break;
-  }
-  case SMT_FUNC_BVULTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, false));
-    break;
-  }
-  case SMT_FUNC_BVSGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVSLT, _args, 2);
-    return mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-  }
-  case SMT_FUNC_BVSLTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVSGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVSLT, args2, 2);
-  }
-  case SMT_FUNC_BVSLT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(false, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVMUL:
-  {
-    result = new_ast(ressort);
-    const bitblast_smt_sort *sort0 = bitblast_sort_downcast(args[0]->sort);
-    const bitblast_smt_sort *sort1 = bitblast_sort_downcast(args[1]->sort);
-    if(sort0->sign || sort1->sign)
-    {
-      signed_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    else
-    {
-      unsigned_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    break;
-  }
-  case SMT_FUNC_CONCAT:
-  {
-    result = new_ast(ressort);
-    result->bv.insert(
-      result->bv.begin(), args[0]->bv.begin(), args[0]->bv.end());
-    result->bv.insert(
-      result->bv.begin(), args[1]->bv.begin(), args[1]->bv.end());
-    break;
-  }
-  case SMT_FUNC_BVAND:
-  {
-    result = new_ast(ressort);
-    bvand(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVXOR:
-  {
-    result = new_ast(ressort);
-    bvxor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVOR:
-  {
-    result = new_ast(ressort);
-    bvor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNOT:
-  {
-    result = new_ast(ressort);
-    bvnot(args[0]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVASHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::ARIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVLSHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LRIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSHL:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LEFT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVUDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVSMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVUMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNEG:
-  {
-    result = new_ast(ressort);
-    negate(args[0]->bv, result->bv);
-    break;
-  }
-  default:
-    std::cerr << "Unimplemented SMT function \"" << smt_func_name_table[f]
-              << "\" in bitblast convt" << std::endl;
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvmul(smt_astt a, smt_astt b)
+{
+  // The low half of a product is the same whether or not the operands are
+  // signed, so one multiplier serves both.
+  bvt res;
+  unsigned_multiplier(get_bv_lits(a), get_bv_lits(b), res);
+  return new_ast(res, a->sort);
+}
 
-  return result;
+smt_astt bitblast_convt::mk_bvsmod(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  signed_divider(get_bv_lits(a), get_bv_lits(b), res, rem);
+  return new_ast(rem, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvumod(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  unsigned_divider(get_bv_lits(a), get_bv_lits(b), res, rem);
+  return new_ast(rem, a->sort);
 }
 
-smt_sort *bitblast_convt::mk_sort(smt_sort_kind k, ...)
+smt_astt bitblast_convt::mk_bvsdiv(smt_astt a, smt_astt b)
 {
-  va_list ap;
-  bitblast_smt_sort *s = NULL, *dom, *range;
-  unsigned long uint;
-  int thebool;
+  bvt res, rem;
+  signed_divider(get_bv_lits(a), get_bv_lits(b), res, rem);
+  return new_ast(res, a->sort);
+}
 
-  va_start(ap, k);
-  switch(k)
-  {
-  case SMT_SORT_INT:
-    std::cerr << "Can't make Int sorts in bitblaster" << std::endl;
-    abort();
-  case SMT_SORT_REAL:
-    std::cerr << "Can't make Real sorts in bitblaster" << std::endl;
-    abort();
-  case SMT_SORT_BV:
-    uint = va_arg(ap, unsigned long);
-    thebool = va_arg(ap, int);
-    s = new bitblast_smt_sort(k, uint, thebool);
-    break;
-  case SMT_SORT_ARRAY:
-    dom = va_arg(ap, bitblast_smt_sort *); // Consider constness?
-    range = va_arg(ap, bitblast_smt_sort *);
-    s = new bitblast_smt_sort(k, range->data_width, dom->data_width);
-    break;
-  case SMT_SORT_BOOL:
-    s = new bitblast_smt_sort(k);
-    break;
-  default:
-    std::cerr << "Unimplemented SMT sort " << k << " in bitblaster conversion"
-              << std::endl;
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvudiv(smt_astt a, smt_astt b)
+{
+  bvt res, rem;
+  unsigned_divider(get_bv_lits(a), get_bv_lits(b), res, rem);
+  return new_ast(res, a->sort);
+}
 
-  return s;
+smt_astt bitblast_convt::mk_bvshl(smt_astt a, smt_astt b)
+{
+  bvt res;
+  barrel_shift(get_bv_lits(a), LEFT, get_bv_lits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvashr(smt_astt a, smt_astt b)
+{
+  bvt res;
+  barrel_shift(get_bv_lits(a), ARIGHT, get_bv_lits(b), res);
+  return new_ast(res, a->sort);
 }
 
-smt_ast *bitblast_convt::mk_smt_int(const BigInt &intval [[gnu::unused]])
+smt_astt bitblast_convt::mk_bvlshr(smt_astt a, smt_astt b)
+{
+  bvt res;
+  barrel_shift(get_bv_lits(a), LRIGHT, get_bv_lits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvneg(smt_astt a)
+{
+  bvt res;
+  negate(get_bv_lits(a), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvnot(smt_astt a)
+{
+  bvt res;
+  bvnot(get_bv_lits(a), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvnxor(smt_astt a, smt_astt b)
+{
+  return mk_bvnot(mk_bvxor(a, b));
+}
+
+smt_astt bitblast_convt::mk_bvnor(smt_astt a, smt_astt b)
+{
+  return mk_bvnot(mk_bvor(a, b));
+}
+
+smt_astt bitblast_convt::mk_bvnand(smt_astt a, smt_astt b)
+{
+  return mk_bvnot(mk_bvand(a, b));
+}
+
+smt_astt bitblast_convt::mk_bvxor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvxor(get_bv_lits(a), get_bv_lits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvor(get_bv_lits(a), get_bv_lits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_bvand(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvand(get_bv_lits(a), get_bv_lits(b), res);
+  return new_ast(res, a->sort);
+}
+
+smt_astt bitblast_convt::mk_implies(smt_astt a, smt_astt b)
+{
+  literalt l = sat_api->limplies(get_bv_lits(a)[0], get_bv_lits(b)[0]);
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_xor(smt_astt a, smt_astt b)
+{
+  literalt l = sat_api->lxor(get_bv_lits(a)[0], get_bv_lits(b)[0]);
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_or(smt_astt a, smt_astt b)
+{
+  literalt l = sat_api->lor(get_bv_lits(a)[0], get_bv_lits(b)[0]);
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_and(smt_astt a, smt_astt b)
+{
+  literalt l = sat_api->land(get_bv_lits(a)[0], get_bv_lits(b)[0]);
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_not(smt_astt a)
+{
+  literalt l = sat_api->lnot(get_bv_lits(a)[0]);
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_bvult(smt_astt a, smt_astt b)
+{
+  literalt l = unsigned_less_than(get_bv_lits(a), get_bv_lits(b));
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_bvslt(smt_astt a, smt_astt b)
+{
+  literalt l = lt_or_le(false, get_bv_lits(a), get_bv_lits(b), true);
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_bvugt(smt_astt a, smt_astt b)
+{
+  return mk_bvult(b, a);
+}
+
+smt_astt bitblast_convt::mk_bvsgt(smt_astt a, smt_astt b)
+{
+  return mk_bvslt(b, a);
+}
+
+smt_astt bitblast_convt::mk_bvule(smt_astt a, smt_astt b)
+{
+  return mk_not(mk_bvult(b, a));
+}
+
+smt_astt bitblast_convt::mk_bvsle(smt_astt a, smt_astt b)
+{
+  return mk_not(mk_bvslt(b, a));
+}
+
+smt_astt bitblast_convt::mk_bvuge(smt_astt a, smt_astt b)
+{
+  return mk_not(mk_bvult(a, b));
+}
+
+smt_astt bitblast_convt::mk_bvsge(smt_astt a, smt_astt b)
+{
+  return mk_not(mk_bvslt(a, b));
+}
+
+smt_astt bitblast_convt::mk_eq(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id != SMT_SORT_ARRAY && b->sort->id != SMT_SORT_ARRAY);
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+
+  literalt l = equal(get_bv_lits(a), get_bv_lits(b));
+  return new_ast(bvt(1, l), boolean_sort);
+}
+
+smt_astt bitblast_convt::mk_neq(smt_astt a, smt_astt b)
+{
+  return mk_not(mk_eq(a, b));
+}
+
+smt_sortt bitblast_convt::mk_bool_sort()
+{
+  return new smt_sort(SMT_SORT_BOOL, 1);
+}
+
+smt_sortt bitblast_convt::mk_bv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_BV, width);
+}
+
+smt_sortt bitblast_convt::mk_fbv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_FIXEDBV, width);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_sort(std::size_t ew, std::size_t sw)
+{
+  return new smt_sort(SMT_SORT_BVFP, ew + sw + 1, sw + 1);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_rm_sort()
+{
+  return new smt_sort(SMT_SORT_BVFP_RM, 3);
+}
+
+smt_sortt bitblast_convt::mk_array_sort(smt_sortt domain, smt_sortt range)
+{
+  // Only ever seen by array_convt, which flattens arrays into their elements.
+  return new smt_sort(SMT_SORT_ARRAY, domain->get_data_width(), range);
+}
+
+smt_astt bitblast_convt::mk_smt_int(const BigInt &theint [[gnu::unused]])
 {
   std::cerr << "Can't create integers in bitblast solver" << std::endl;
   abort();
 }
 
-smt_ast *bitblast_convt::mk_smt_real(const std::string &value [[gnu::unused]])
+smt_astt bitblast_convt::mk_smt_real(const std::string &str [[gnu::unused]])
 {
   std::cerr << "Can't create reals in bitblast solver" << std::endl;
   abort();
 }
 
-smt_ast *
-bitblast_convt::mk_smt_bvint(const BigInt &intval, bool sign, unsigned int w)
+smt_astt bitblast_convt::mk_smt_bv(const BigInt &theint, smt_sortt s)
 {
-  smt_sort *s = mk_sort(SMT_SORT_BV, w, sign);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.resize(w);
-  int u = intval.to_int64();
-  for(unsigned int i = 0; i < w; i++)
-  {
-    int mask = (1ULL << i);
-    bool val = u & mask;
-    a->bv[i] = const_literal(val);
-  }
+  std::size_t width = s->get_data_width();
+  std::string bits = integer2binary(theint, width);
 
-  return a;
+  bvt bv(width);
+  for(std::size_t i = 0; i < width; i++)
+    bv[i] = const_literal(bits[width - i - 1] == '1');
+
+  return new_ast(bv, s);
 }
 
-smt_ast *bitblast_convt::mk_smt_bool(bool boolval)
+smt_astt bitblast_convt::mk_smt_bool(bool val)
 {
-  literalt l = const_literal(boolval);
-
-  smt_sort *s = mk_sort(SMT_SORT_BOOL);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.push_back(l);
-  return a;
+  return new_ast(bvt(1, const_literal(val)), boolean_sort);
 }
 
-smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt sort)
+smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt s)
 {
-  // Otherwise, we need to build this AST ourselves.
-  bitblast_smt_ast *a = new_ast(sort);
-  smt_astt result = a;
-  const bitblast_smt_sort *s = bitblast_sort_downcast(sort);
-  switch(sort->id)
+  symtable_type::iterator it = symtable.find(name);
+  if(it != symtable.end())
+    return new_ast(it->second, s);
+
+  switch(s->id)
   {
   case SMT_SORT_BOOL:
-  {
-    literalt l = sat_api->new_variable();
-    a->bv.push_back(l);
-    break;
-  }
   case SMT_SORT_BV:
-  {
-    // Bunch of fresh variables
-    for(unsigned int i = 0; i < s->data_width; i++)
-      a->bv.push_back(sat_api->new_variable());
+  case SMT_SORT_FIXEDBV:
+  case SMT_SORT_BVFP:
+  case SMT_SORT_BVFP_RM:
     break;
-  }
   default:
-    std::cerr << "Unimplemented symbol type " << sort->id
+    std::cerr << "Unimplemented symbol sort " << s->id
               << " in bitblast symbol creation" << std::endl;
     abort();
   }
 
-  return result;
+  // Bunch of fresh variables
+  bvt &bv = symtable[name];
+  bv.reserve(s->get_data_width());
+  for(std::size_t i = 0; i < s->get_data_width(); i++)
+    bv.push_back(sat_api->new_variable());
+
+  return new_ast(bv, s);
 }
 
-smt_sort *bitblast_convt::mk_struct_sort(const type2tc &t [[gnu::unused]])
+smt_astt
+bitblast_convt::mk_extract(smt_astt a, unsigned int high, unsigned int low)
 {
-  abort();
+  const bvt &src = get_bv_lits(a);
+  assert(high < src.size() && low <= high);
+
+  bvt bv(src.begin() + low, src.begin() + high + 1);
+  return new_ast(bv, mk_bv_sort(high - low + 1));
 }
 
-smt_ast *bitblast_convt::mk_extract(
-  smt_astt src,
-  unsigned int high,
-  unsigned int low,
-  smt_sortt s)
+smt_astt bitblast_convt::mk_sign_ext(smt_astt a, unsigned int topwidth)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(src);
-  bitblast_smt_ast *result = new_ast(s);
-  for(unsigned int i = low; i <= high; i++)
-    result->bv.push_back(mast->bv[i]);
-
-  return result;
+  bvt bv = get_bv_lits(a);
+  literalt top = bv.back();
+  bv.insert(bv.end(), topwidth, top);
+  return new_ast(bv, mk_bv_sort(bv.size()));
 }
 
-bitblast_smt_ast *
-bitblast_convt::mk_ast_equality(smt_astt _a, smt_astt _b, smt_sortt ressort)
+smt_astt bitblast_convt::mk_zero_ext(smt_astt a, unsigned int topwidth)
 {
-  const bitblast_smt_ast *a = bitblast_ast_downcast(_a);
-  const bitblast_smt_ast *b = bitblast_ast_downcast(_b);
+  bvt bv = get_bv_lits(a);
+  bv.insert(bv.end(), topwidth, const_literal(false));
+  return new_ast(bv, mk_bv_sort(bv.size()));
+}
 
-  switch(a->sort->id)
-  {
-  case SMT_SORT_BOOL:
-  {
-    literalt res = sat_api->lequal(a->bv[0], b->bv[0]);
-    bitblast_smt_ast *n = new_ast(a->sort);
-    n->bv.push_back(res);
-    return n;
-  }
-  case SMT_SORT_BV:
-  {
-    bitblast_smt_ast *n = new_ast(ressort);
-    n->bv.push_back(equal(a->bv, b->bv));
-    return n;
-  }
-  case SMT_SORT_ARRAY:
-  {
-    // XXX - so, if we have different array encodings in the future then this
-    // might get quite funky. Leave it until then, though.
-    std::cerr << "No direct array equality support in bitblast converter"
-              << std::endl;
-    abort();
-  }
-  default:
-    std::cerr << "Invalid sort " << a->sort->id << " for equality in bitblast"
-              << std::endl;
-    abort();
-  }
+smt_astt bitblast_convt::mk_concat(smt_astt a, smt_astt b)
+{
+  // a forms the top bits of the result.
+  bvt bv = get_bv_lits(b);
+  const bvt &top = get_bv_lits(a);
+  bv.insert(bv.end(), top.begin(), top.end());
+  return new_ast(bv, mk_bv_sort(bv.size()));
 }
 
-expr2tc bitblast_convt::get_bool(smt_astt a)
+smt_astt bitblast_convt::mk_ite(smt_astt cond, smt_astt t, smt_astt f)
 {
-  tvt t = l_get(a);
-  if(t.is_true())
-    return gen_true_expr();
-  else if(t.is_false())
-    return gen_false_expr();
-  else
-    return expr2tc();
+  assert(cond->sort->id == SMT_SORT_BOOL);
+  assert(t->sort->get_data_width() == f->sort->get_data_width());
+
+  literalt c = get_bv_lits(cond)[0];
+  const bvt &tv = get_bv_lits(t);
+  const bvt &fv = get_bv_lits(f);
+
+  bvt bv;
+  bv.reserve(tv.size());
+  for(std::size_t i = 0; i < tv.size(); i++)
+    bv.push_back(sat_api->lselect(c, tv[i], fv[i]));
+
+  return new_ast(bv, t->sort);
 }
 
 tvt bitblast_convt::l_get(smt_astt a)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  return sat_api->l_get(mast->bv[0]);
+  return sat_api->l_get(get_bv_lits(a)[0]);
 }
 
-expr2tc bitblast_convt::get_bv(const type2tc &t, smt_astt a)
+bool bitblast_convt::get_bool(smt_astt a)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  unsigned int sz = t->get_width();
-  assert(sz <= 64 && "Your integers are larger than a uint64_t");
-  assert(mast->bv.size() == sz);
-  uint64_t accuml = 0;
-  for(unsigned int i = 0; i < sz; i++)
-  {
-    uint64_t mask = 1 << i;
-    tvt t = sat_api->l_get(mast->bv[i]);
-    if(t.is_true())
-    {
-      accuml |= mask;
-    }
-    else if(t.is_false())
-    {
-      ; // It's zero
-    }
-    else
-    {
-      ; // It's undefined in this model. So may as well be zero.
-    }
-  }
+  return l_get(a).is_true();
+}
 
-  return constant_int2tc(t, BigInt(accuml));
+BigInt bitblast_convt::get_bv(smt_astt a, bool is_signed)
+{
+  const bvt &bv = get_bv_lits(a);
+
+  // Bits left undefined by the model may as well be zero.
+  std::string bits(bv.size(), '0');
+  for(std::size_t i = 0; i < bv.size(); i++)
+    if(sat_api->l_get(bv[i]).is_true())
+      bits[bv.size() - i - 1] = '1';
+
+  return binary2integer(bits, is_signed);
 }
 
 // ******************************  Bitblast foo *******************************
@@ -605,27 +522,6 @@ void bitblast_convt::unsigned_multiplier(
   }
 }
 
-void bitblast_convt::signed_multiplier(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &output)
-{
-  assert(op0.size() == op1.size() && op0.size() != 0);
-  literalt sign0 = op0[op0.size() - 1];
-  literalt sign1 = op1[op1.size() - 1];
-
-  bvt neg0, neg1;
-  cond_negate(op0, neg0, sign0);
-  cond_negate(op1, neg1, sign1);
-
-  bvt tmp;
-  unsigned_multiplier(neg0, neg1, tmp);
-
-  literalt res_sign = sat_api->lxor(sign0, sign1);
-
-  cond_negate(tmp, output, res_sign);
-}
-
 void bitblast_convt::cond_negate(const bvt &vals, bvt &out, literalt cond)
 {
   bvt inv;
@@ -707,8 +603,9 @@ void bitblast_convt::signed_divider(
   for(unsigned int i = 0; i < res.size(); i++)
     res[i] = sat_api->lselect(result_sign, neg_res[i], res[i]);
 
+  // The remainder takes the sign of the dividend, as with bvsrem.
   for(unsigned int i = 0; i < rem.size(); i++)
-    rem[i] = sat_api->lselect(result_sign, neg_rem[i], rem[i]);
+    rem[i] = sat_api->lselect(sign0, neg_rem[i], rem[i]);
 
   return;
 }
@@ -752,7 +649,7 @@ void bitblast_convt::unsigned_divider(
   // "op1 != 0 => res <= op0"
 
   sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(true, rem, op0, false)));
+    sat_api->limplies(is_not_zero, lt_or_le(true, res, op0, false)));
 }
 
 void bitblast_convt::unsigned_multiplier_no_overflow(
@@ -771,9 +668,9 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
   for(unsigned int i = 0; i < res.size(); i++)
     res[i] = const_literal(false);
 
-  for(unsigned int sum = 0; sum < op0.size(); sum++)
+  for(unsigned int sum = 0; sum < _op0.size(); sum++)
   {
-    if(op0[sum] != const_literal(false))
+    if(_op0[sum] != const_literal(false))
     {
       bvt tmpop;
 
@@ -783,14 +680,14 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
         tmpop.push_back(const_literal(false));
 
       for(unsigned int idx = sum; idx < res.size(); idx++)
-        tmpop.push_back(sat_api->land(op1[idx - sum], op0[sum]));
+        tmpop.push_back(sat_api->land(_op1[idx - sum], _op0[sum]));
 
       bvt copy = res;
       adder_no_overflow(copy, tmpop, res);
 
-      for(unsigned int idx = op1.size() - sum; idx < op1.size(); idx++)
+      for(unsigned int idx = _op1.size() - sum; idx < _op1.size(); idx++)
       {
-        literalt tmp = sat_api->land(op1[idx], op0[sum]);
+        literalt tmp = sat_api->land(_op1[idx], _op0[sum]);
         tmp.invert();
         sat_api->assert_lit(tmp);
       }
@@ -798,49 +695,6 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
   }
 }
 
-void bitblast_convt::adder_no_overflow(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &res,
-  bool subtract,
-  bool is_signed)
-{
-  assert(op0.size() == op1.size());
-  unsigned int width = op0.size();
-  bvt tmp_op1 = op1;
-  if(subtract)
-    negate(op1, tmp_op1);
-
-  if(is_signed)
-  {
-    literalt old_sign = op0[width - 1];
-    literalt sign_the_same =
-      sat_api->lequal(op0[width - 1], tmp_op1[width - 1]);
-    literalt carry;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry);
-    literalt stop_overflow =
-      sat_api->land(sign_the_same, sat_api->lxor(op0[width - 1], old_sign));
-    stop_overflow.invert();
-    sat_api->assert_lit(stop_overflow);
-  }
-  else
-  {
-    literalt carry_out;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry_out);
-    if(subtract)
-    {
-      sat_api->assert_lit(carry_out);
-    }
-    else
-    {
-      carry_out.invert();
-      sat_api->assert_lit(carry_out);
-    }
-  }
-
-  return;
-}
-
 void bitblast_convt::adder_no_overflow(const bvt &op0, const bvt &op1, bvt &res)
 {
   res.resize(op0.size());
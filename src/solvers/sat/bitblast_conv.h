@@ -1,46 +1,21 @@
 #ifndef _ESBMC_SOLVERS_SMT_BITBLAST_CONV_H_
 #define _ESBMC_SOLVERS_SMT_BITBLAST_CONV_H_
 
+#include <unordered_map>
+#include <solvers/prop/literal.h>
 #include <solvers/smt/smt_conv.h>
+#include <util/threeval.h>
 #include <sat_iface.h>
 
-class bitblast_smt_sort : public smt_sort
+// Everything is, to a greater or lesser extend, a vector of booleans. Bit zero
+// of the vector is the least significant bit; booleans are one-bit vectors.
+class bitblast_smt_ast : public solver_smt_ast<bvt>
 {
-  // Record all the things.
 public:
-#define bitblast_sort_downcast(x) static_cast<const bitblast_smt_sort *>(x)
+  using solver_smt_ast<bvt>::solver_smt_ast;
+  ~bitblast_smt_ast() override = default;
 
-  bitblast_smt_sort(smt_sort_kind i) : smt_sort(i), sign(false)
-  {
-  }
-  bitblast_smt_sort(smt_sort_kind i, unsigned int _width, bool _sign)
-    : smt_sort(i, _width), sign(_sign)
-  {
-  }
-  bitblast_smt_sort(
-    smt_sort_kind i,
-    unsigned long rangewidth,
-    unsigned long domwidth)
-    : smt_sort(i, rangewidth, domwidth), sign(false)
-  {
-  }
-
-  bool sign;
-  virtual ~bitblast_smt_sort()
-  {
-  }
-};
-
-class bitblast_smt_ast : public smt_ast
-{
-public:
-#define bitblast_ast_downcast(x) static_cast<const bitblast_smt_ast *>(x)
-  bitblast_smt_ast(smt_convt *ctx, const smt_sort *s) : smt_ast(ctx, s)
-  {
-  }
-
-  // Everything is, to a greater or lesser extend, a vector of booleans
-  bvt bv;
+  void dump() const override;
 };
 
 class bitblast_convt : public smt_convt
@@ -54,58 +29,74 @@ public:
   } shiftt;
 
   bitblast_convt(bool int_encoding, const namespacet &_ns, sat_iface *sat_api);
-  ~bitblast_convt();
-
-  // The plan: have a mk_func_app method available, that's called by the
-  // subclass when appropriate, and if there's an operation on bitvectors
-  // in there, we convert it to an operation on literals, implemented using
-  // the abstract api below.
-  //
-  // This means that the subclass relinquishes all control over both ASTs
-  // and sorts: this class will manage all of that. Only operations on literals
-  // will reach the subclass (via the aforementioned api), and crucially that's
-  // _all_ operations. Operations on booleans from a higher level should all
-  // pass through this class before becoming a literal operation.
-  //
-  // (This alas is not the truth yet, but it's an aim).
-  //
-  // The remanining flexibility options available to the solver are then only
-  // in the domain of logical operations on literals, although all kinds of
-  // other API things can be fudged, such as tuples and arrays.
-
-  // Update: SAT solver no longer subclasses this class, it instead provides a
-  // SAT api pointer. Documentation not yet updated, sorry.
-
-  // smt_convt apis we fufil
-
-  virtual smt_astt mk_func_app(
-    const smt_sort *ressort,
-    smt_func_kind f,
-    const smt_ast *const *args,
-    unsigned int num);
-  virtual smt_sort *mk_sort(smt_sort_kind k, ...);
-  virtual smt_ast *mk_smt_int(const BigInt &intval);
-  virtual smt_ast *mk_smt_real(const std::string &value);
-  virtual smt_ast *mk_smt_bvint(const BigInt &inval, bool sign, unsigned int w);
-  virtual smt_ast *mk_smt_bool(bool boolval);
-  virtual smt_astt mk_smt_symbol(const std::string &name, const smt_sort *sort);
-  virtual smt_sort *mk_struct_sort(const type2tc &t);
-  virtual smt_ast *mk_extract(
-    const smt_ast *src,
-    unsigned int high,
-    unsigned int low,
-    const smt_sort *s);
-  virtual tvt l_get(const smt_ast *a);
-  virtual void assert_ast(const smt_ast *a);
-
-  // Some gunk
-  expr2tc get_bool(const smt_ast *a);
-  expr2tc get_bv(const type2tc &t, const smt_ast *a);
+  ~bitblast_convt() override = default;
+
+  // Bool and bit-vector operations are flattened here into operations on
+  // literals, through the sat_iface api below. Arrays, tuples and floats are
+  // left to the array_convt, tuple flattener and fp_convt defaults, which in
+  // turn reduce them to the operations implemented here. The subclass only
+  // has to provide the literal api and the actual SAT solving.
+
+  void assert_ast(smt_astt a) override;
+
+  smt_astt mk_bvadd(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvsub(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvmul(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvsmod(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvumod(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvsdiv(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvudiv(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvshl(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvashr(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvlshr(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvneg(smt_astt a) override;
+  smt_astt mk_bvnot(smt_astt a) override;
+  smt_astt mk_bvnxor(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvnor(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvnand(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvxor(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvor(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvand(smt_astt a, smt_astt b) override;
+  smt_astt mk_implies(smt_astt a, smt_astt b) override;
+  smt_astt mk_xor(smt_astt a, smt_astt b) override;
+  smt_astt mk_or(smt_astt a, smt_astt b) override;
+  smt_astt mk_and(smt_astt a, smt_astt b) override;
+  smt_astt mk_not(smt_astt a) override;
+  smt_astt mk_bvult(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvslt(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvugt(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvsgt(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvule(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvsle(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvuge(smt_astt a, smt_astt b) override;
+  smt_astt mk_bvsge(smt_astt a, smt_astt b) override;
+  smt_astt mk_eq(smt_astt a, smt_astt b) override;
+  smt_astt mk_neq(smt_astt a, smt_astt b) override;
+
+  smt_sortt mk_bool_sort() override;
+  smt_sortt mk_bv_sort(std::size_t width) override;
+  smt_sortt mk_fbv_sort(std::size_t width) override;
+  smt_sortt mk_bvfp_sort(std::size_t ew, std::size_t sw) override;
+  smt_sortt mk_bvfp_rm_sort() override;
+  smt_sortt mk_array_sort(smt_sortt domain, smt_sortt range) override;
+
+  smt_astt mk_smt_int(const BigInt &theint) override;
+  smt_astt mk_smt_real(const std::string &str) override;
+  smt_astt mk_smt_bv(const BigInt &theint, smt_sortt s) override;
+  smt_astt mk_smt_bool(bool val) override;
+  smt_astt mk_smt_symbol(const std::string &name, smt_sortt s) override;
+  smt_astt mk_extract(smt_astt a, unsigned int high, unsigned int low) override;
+  smt_astt mk_sign_ext(smt_astt a, unsigned int topwidth) override;
+  smt_astt mk_zero_ext(smt_astt a, unsigned int topwidth) override;
+  smt_astt mk_concat(smt_astt a, smt_astt b) override;
+  smt_astt mk_ite(smt_astt cond, smt_astt t, smt_astt f) override;
+
+  tvt l_get(smt_astt a) override;
+  bool get_bool(smt_astt a) override;
+  BigInt get_bv(smt_astt a, bool is_signed) override;
 
   // Bitblasting utilities, mostly from CBMC.
   bool process_clause(const bvt &bv, bvt &dest);
-  bitblast_smt_ast *
-  mk_ast_equality(const smt_ast *a, const smt_ast *b, const smt_sort *ressort);
   virtual literalt land(const bvt &bv);
   virtual literalt lor(const bvt &bv);
   void eliminate_duplicates(const bvt &bv, bvt &dest);
@@ -129,7 +120,6 @@ public:
   void shift(const bvt &inp, const shiftt &s, unsigned long d, bvt &out);
   literalt unsigned_less_than(const bvt &arg0, const bvt &arg1);
   void unsigned_multiplier(const bvt &op0, const bvt &bv1, bvt &output);
-  void signed_multiplier(const bvt &op0, const bvt &bv1, bvt &output);
   void cond_negate(const bvt &vals, bvt &out, literalt cond);
   void negate(const bvt &inp, bvt &oup);
   void incrementer(
@@ -140,22 +130,26 @@ public:
   void signed_divider(const bvt &op0, const bvt &op1, bvt &res, bvt &rem);
   void unsigned_divider(const bvt &op0, const bvt &op1, bvt &res, bvt &rem);
   void unsigned_multiplier_no_overflow(const bvt &op0, const bvt &op1, bvt &r);
-  void adder_no_overflow(
-    const bvt &op0,
-    const bvt &op1,
-    bvt &res,
-    bool subtract,
-    bool is_signed);
   void adder_no_overflow(const bvt &op0, const bvt &op1, bvt &res);
   bool is_constant(const bvt &bv);
 
-  inline bitblast_smt_ast *new_ast(smt_sortt ressort)
+  inline smt_astt new_ast(bvt bv, smt_sortt s)
   {
-    return new bitblast_smt_ast(this, ressort);
+    return new bitblast_smt_ast(this, std::move(bv), s);
+  }
+
+  static const bvt &get_bv_lits(smt_astt a)
+  {
+    return to_solver_smt_ast<bitblast_smt_ast>(a)->a;
   }
 
   // Members
   sat_iface *sat_api;
+
+  // Symbols map to the literals they were first given, across context pops,
+  // so that a name always denotes the same solver variables.
+  typedef std::unordered_map<std::string, bvt> symtable_type;
+  symtable_type symtable;
 };
 
 #endif /* _ESBMC_SOLVERS_SMT_BITBLAST_CONV_H_ */
@@ -22,9 +22,9 @@ literalt cnf_convt::lselect(literalt a, literalt b, literalt c)
     return c;
   if(b == c)
     return b;
+  if(b == lnot(c))
+    return lequal(a, b);
 
-  bvt bv;
-  bv.reserve(2);
   literalt one = land(a, b);
   literalt two = land(lnot(a), c);
   return lor(one, two);
@@ -50,26 +50,31 @@ literalt cnf_convt::lxor(literalt a, literalt b)
     return lnot(b);
   if(b == const_literal(true))
     return lnot(a);
+  if(a == b)
+    return const_literal(false);
+  if(a == lnot(b))
+    return const_literal(true);
+
+  // Push the input signs onto the output, so that all four polarities of a
+  // xor over the same two variables share one gate.
+  bool invert = a.sign() != b.sign();
+  a.cond_invert(a.sign());
+  b.cond_invert(b.sign());
+
+  auto it = xor_cache.find(gate_key(a, b));
+  if(it != xor_cache.end())
+    return it->second.cond_negation(invert);
 
   literalt output = this->new_variable();
   gate_xor(a, b, output);
-  return output;
+  xor_cache.emplace(gate_key(a, b), output);
+  return output.cond_negation(invert);
 }
 
 literalt cnf_convt::lor(literalt a, literalt b)
 {
-  if(a == const_literal(false))
-    return b;
-  if(b == const_literal(false))
-    return a;
-  if(a == const_literal(true))
-    return const_literal(true);
-  if(b == const_literal(true))
-    return const_literal(true);
-
-  literalt output = this->new_variable();
-  gate_or(a, b, output);
-  return output;
+  // a | b == !(!a & !b)
+  return lnot(land(lnot(a), lnot(b)));
 }
 
 literalt cnf_convt::land(literalt a, literalt b)
@@ -84,9 +89,16 @@ literalt cnf_convt::land(literalt a, literalt b)
     return const_literal(false);
   if(a == b)
     return a;
+  if(a == lnot(b))
+    return const_literal(false);
+
+  auto it = and_cache.find(gate_key(a, b));
+  if(it != and_cache.end())
+    return it->second;
 
   literalt output = this->new_variable();
   gate_and(a, b, output);
+  and_cache.emplace(gate_key(a, b), output);
   return output;
 }
 
@@ -1,6 +1,7 @@
 #ifndef _ESBMC_SOLVERS_SMT_CNF_CONV_H_
 #define _ESBMC_SOLVERS_SMT_CNF_CONV_H_
 
+#include <unordered_map>
 #include <solvers/smt/smt_conv.h>
 #include <bitblast_conv.h>
 #include <cnf_iface.h>
@@ -25,6 +26,23 @@ public:
   virtual void set_equal(literalt a, literalt b);
 
   cnf_iface *cnf_api;
+
+protected:
+  /** Structural hashing: every AND and XOR gate is keyed on its (ordered)
+   *  input literals, so building the same gate twice hands back the output
+   *  literal of the first one instead of a fresh variable and more clauses.
+   *  OR is built as an AND over inverted literals, so it shares and_cache.
+   *  Gate clauses are never retracted, so neither cache needs scoping. */
+  typedef std::unordered_map<uint64_t, literalt> gate_cachet;
+  gate_cachet and_cache;
+  gate_cachet xor_cache;
+
+  static uint64_t gate_key(literalt a, literalt b)
+  {
+    if(b < a)
+      std::swap(a, b);
+    return (uint64_t(a.get()) << 32) | uint64_t(b.get());
+  }
 };
 
 #endif /* _ESBMC_SOLVERS_SMT_CNF_CONV_H_ */
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <set>
 #include <solvers/smt/array_conv.h>
+#include <unordered_map>
 #include <util/c_types.h>
 #include <utility>
 
@@ -20,7 +21,8 @@ static inline bool array_indexes_are_same(
   return true;
 }
 
-array_convt::array_convt(smt_convt *_ctx) : array_iface(true, true), ctx(_ctx)
+array_convt::array_convt(smt_convt *_ctx, bool _lazy_ackermann)
+  : array_iface(true, true), lazy_ackermann(_lazy_ackermann), ctx(_ctx)
 {
 }
 
@@ -845,9 +847,10 @@ void array_convt::add_new_indexes()
         array_values[0], arrid, 0, subtype, start_pos[arrid]);
     }
 
-    // Apply inital ackerman constraints
-    add_initial_ackerman_constraints(
-      array_values[0], expr_index_map[arrid], start_pos[arrid]);
+    // Apply inital ackerman constraints, unless they're to be added on demand
+    if(!can_defer_ackerman_constraints(arrid))
+      add_initial_ackerman_constraints(
+        array_values[0], expr_index_map[arrid], start_pos[arrid]);
 
     // And finally, re-execute the relevant array transitions
     for(unsigned int i = 0; i < array_updates[arrid].size() - 1; i++)
@@ -1316,6 +1319,73 @@ void array_convt::add_initial_ackerman_constraints(
   }
 }
 
+bool array_convt::can_defer_ackerman_constraints(unsigned int arrid) const
+{
+  if(!lazy_ackermann)
+    return false;
+
+  // Refinement has to compare element values in the model, which we can only
+  // do for elements that read back as a single bool or bitvector.
+  switch(array_subtypes[arrid]->id)
+  {
+  case SMT_SORT_BOOL:
+  case SMT_SORT_BV:
+  case SMT_SORT_FIXEDBV:
+  case SMT_SORT_BVFP:
+  case SMT_SORT_BVFP_RM:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool array_convt::refine_array_constraints()
+{
+  // The ackerman constraints only relate the initial values of each array;
+  // updates, ites and selects are all encoded eagerly in terms of those, so
+  // if the initial values are consistent then so is everything else. Group
+  // the indexes of each array by their value in the model, and wherever two
+  // indexes in a group have different initial values, assert the constraint
+  // that rules this out. A violated constraint can't already be asserted, so
+  // there's no need to track which ones have been added.
+  bool refined = false;
+
+  for(unsigned int arrid = 0; arrid < array_valuation.size(); arrid++)
+  {
+    if(!can_defer_ackerman_constraints(arrid))
+      continue;
+
+    const ast_vect &vals = array_valuation[arrid][0];
+    bool is_bool = array_subtypes[arrid]->id == SMT_SORT_BOOL;
+
+    std::unordered_map<expr2tc, const index_map_rect *, irep2_hash> seen;
+    for(auto const &it : expr_index_map[arrid])
+    {
+      smt_astt idx = ctx->convert_ast(it.idx);
+      expr2tc idx_val = ctx->get_by_ast(it.idx->type, idx);
+      if(is_nil_expr(idx_val))
+        continue;
+
+      auto first = seen.emplace(idx_val, &it);
+      if(first.second)
+        continue;
+
+      const index_map_rect &rep = *first.first->second;
+      smt_astt a = vals[rep.vec_idx], b = vals[it.vec_idx];
+      bool same = is_bool ? ctx->get_bool(a) == ctx->get_bool(b)
+                          : ctx->get_bv(a, false) == ctx->get_bv(b, false);
+      if(same)
+        continue;
+
+      smt_astt idxeq = ctx->convert_ast(rep.idx)->eq(ctx, idx);
+      ctx->assert_ast(ctx->mk_implies(idxeq, a->eq(ctx, b)));
+      refined = true;
+    }
+  }
+
+  return refined;
+}
+
 smt_astt array_ast::eq(smt_convt *ctx [[gnu::unused]], smt_astt sym) const
 {
   const array_ast *other = array_downcast(sym);
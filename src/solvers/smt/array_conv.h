@@ -16,6 +16,10 @@
 //
 // As a result, this particular class is due some serious maintenence.
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <set>
 #include <solvers/smt/smt_conv.h>
 #include <util/irep2.h>
@@ -114,7 +118,7 @@ public:
         std::greater<unsigned int>>>>
     index_map_containert;
 
-  array_convt(smt_convt *_ctx);
+  array_convt(smt_convt *_ctx, bool _lazy_ackermann = false);
   ~array_convt() = default;
 
   // Public api
@@ -127,6 +131,7 @@ public:
   smt_astt
   convert_array_of(smt_astt init_val, unsigned long domain_width) override;
   void add_array_constraints_for_solving() override;
+  bool refine_array_constraints() override;
 
   // Heavy lifters
   virtual smt_astt convert_array_of_wsort(
@@ -222,6 +227,7 @@ public:
     const ast_vect &vals,
     const index_map_containert &idx_map,
     unsigned int start_point);
+  bool can_defer_ackerman_constraints(unsigned int arrid) const;
   void add_new_indexes();
   void execute_new_updates();
   void apply_new_selects();
@@ -437,6 +443,11 @@ public:
   // In reverse, these correspond to ast_vect and array_update_vect
   std::vector<std::vector<std::vector<smt_astt>>> array_valuation;
 
+  // When set, the ackerman constraints between the initial values of an array
+  // are not encoded up front: refine_array_constraints adds just those that
+  // a satisfying assignment turns out to violate.
+  bool lazy_ackermann;
+
   smt_convt *ctx;
 };
 
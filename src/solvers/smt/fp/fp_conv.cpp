@@ -86,7 +86,34 @@ smt_astt fp_convt::mk_smt_fpbv_inf(bool sgn, unsigned ew, unsigned sw)
 
 smt_astt fp_convt::mk_smt_fpbv_rm(ieee_floatt::rounding_modet rm)
 {
-  return ctx->mk_smt_bv(BigInt(rm), 3);
+  auto it = rm_asts.find(rm);
+  if(it != rm_asts.end())
+    return it->second;
+
+  smt_astt a = ctx->mk_smt_bv(BigInt(rm), 3);
+  rm_asts.emplace(rm, a);
+  const_rms.emplace(a, rm);
+  return a;
+}
+
+bool fp_convt::get_const_rm(smt_astt rm, ieee_floatt::rounding_modet &out)
+  const
+{
+  auto it = const_rms.find(rm);
+  if(it == const_rms.end())
+    return false;
+
+  out = it->second;
+  return true;
+}
+
+void fp_convt::pop_fp_ctx()
+{
+  op_cache.clear();
+  unpack_cache[0].clear();
+  unpack_cache[1].clear();
+  rm_asts.clear();
+  const_rms.clear();
 }
 
 smt_astt fp_convt::mk_smt_nearbyint_from_float(smt_astt x, smt_astt rm)
@@ -269,6 +296,11 @@ smt_astt fp_convt::mk_smt_nearbyint_from_float(smt_astt x, smt_astt rm)
 
 smt_astt fp_convt::mk_smt_fpbv_sqrt(smt_astt x, smt_astt rm)
 {
+  const op_keyt key(FP_SQRT, x, nullptr, nullptr, rm);
+  auto cached = op_cache.find(key);
+  if(cached != op_cache.end())
+    return cached->second;
+
   unsigned ebits = x->sort->get_exponent_width();
   unsigned sbits = x->sort->get_significand_width();
 
@@ -368,12 +400,19 @@ smt_astt fp_convt::mk_smt_fpbv_sqrt(smt_astt x, smt_astt rm)
   smt_astt result = ctx->mk_ite(c4, v4, v5);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt res = ctx->mk_ite(c1, v1, result);
+  op_cache.emplace(key, res);
+  return res;
 }
 
 smt_astt
 fp_convt::mk_smt_fpbv_fma(smt_astt x, smt_astt y, smt_astt z, smt_astt rm)
 {
+  const op_keyt key(FP_FMA, x, y, z, rm);
+  auto cached = op_cache.find(key);
+  if(cached != op_cache.end())
+    return cached->second;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
   assert(x->sort->get_data_width() == z->sort->get_data_width());
@@ -650,7 +689,9 @@ fp_convt::mk_smt_fpbv_fma(smt_astt x, smt_astt y, smt_astt z, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt res = ctx->mk_ite(c1, v1, result);
+  op_cache.emplace(key, res);
+  return res;
 }
 
 smt_astt fp_convt::mk_to_bv(smt_astt x, bool is_signed, std::size_t width)
@@ -1248,6 +1289,11 @@ static void add_core(
 
 smt_astt fp_convt::mk_smt_fpbv_add(smt_astt x, smt_astt y, smt_astt rm)
 {
+  const op_keyt key(FP_ADD, x, y, nullptr, rm);
+  auto cached = op_cache.find(key);
+  if(cached != op_cache.end())
+    return cached->second;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1342,7 +1388,9 @@ smt_astt fp_convt::mk_smt_fpbv_add(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt res = ctx->mk_ite(c1, v1, result);
+  op_cache.emplace(key, res);
+  return res;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_sub(smt_astt lhs, smt_astt rhs, smt_astt rm)
@@ -1353,6 +1401,11 @@ smt_astt fp_convt::mk_smt_fpbv_sub(smt_astt lhs, smt_astt rhs, smt_astt rm)
 
 smt_astt fp_convt::mk_smt_fpbv_mul(smt_astt x, smt_astt y, smt_astt rm)
 {
+  const op_keyt key(FP_MUL, x, y, nullptr, rm);
+  auto cached = op_cache.find(key);
+  if(cached != op_cache.end())
+    return cached->second;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1450,11 +1503,18 @@ smt_astt fp_convt::mk_smt_fpbv_mul(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt res = ctx->mk_ite(c1, v1, result);
+  op_cache.emplace(key, res);
+  return res;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_div(smt_astt x, smt_astt y, smt_astt rm)
 {
+  const op_keyt key(FP_DIV, x, y, nullptr, rm);
+  auto cached = op_cache.find(key);
+  if(cached != op_cache.end())
+    return cached->second;
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1566,7 +1626,9 @@ smt_astt fp_convt::mk_smt_fpbv_div(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt res = ctx->mk_ite(c1, v1, result);
+  op_cache.emplace(key, res);
+  return res;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_eq(smt_astt lhs, smt_astt rhs)
@@ -1753,10 +1815,20 @@ smt_astt fp_convt::mk_smt_fpbv_abs(smt_astt op)
 
 smt_astt fp_convt::mk_smt_fpbv_neg(smt_astt op)
 {
+  // Subtraction negates its rhs every time, so without this no two
+  // subtractions would ever share an addition circuit.
+  const op_keyt key(FP_NEG, op, nullptr, nullptr, nullptr);
+  auto cached = op_cache.find(key);
+  if(cached != op_cache.end())
+    return cached->second;
+
   // Extract everything but the sign bit
   smt_astt ew_sw = extract_exp_sig(ctx, op);
   smt_astt sgn = extract_signbit(ctx, op);
-  return mk_from_bv_to_fp(ctx->mk_concat(ctx->mk_bvnot(sgn), ew_sw), op->sort);
+  smt_astt res =
+    mk_from_bv_to_fp(ctx->mk_concat(ctx->mk_bvnot(sgn), ew_sw), op->sort);
+  op_cache.emplace(key, res);
+  return res;
 }
 
 void fp_convt::unpack(
@@ -1767,6 +1839,16 @@ void fp_convt::unpack(
   smt_astt &lz,
   bool normalize)
 {
+  auto cached = unpack_cache[normalize].find(src);
+  if(cached != unpack_cache[normalize].end())
+  {
+    sgn = cached->second.sgn;
+    sig = cached->second.sig;
+    exp = cached->second.exp;
+    lz = cached->second.lz;
+    return;
+  }
+
   unsigned sbits = src->sort->get_significand_width();
   unsigned ebits = src->sort->get_exponent_width();
 
@@ -1828,6 +1910,8 @@ void fp_convt::unpack(
   assert(sgn->sort->get_data_width() == 1);
   assert(sig->sort->get_data_width() == sbits);
   assert(exp->sort->get_data_width() == ebits);
+
+  unpack_cache[normalize].emplace(src, unpackedt{sgn, sig, exp, lz});
 }
 
 smt_astt fp_convt::mk_unbias(smt_astt &src)
@@ -2107,6 +2191,25 @@ smt_astt fp_convt::mk_rounding_decision(
 
   smt_astt nil_1 = ctx->mk_smt_bv(BigInt(0), 1);
 
+  // With a known rounding mode, only one of the increments is wanted.
+  ieee_floatt::rounding_modet known_rm;
+  if(get_const_rm(rm, known_rm))
+  {
+    switch(known_rm)
+    {
+    case ieee_floatt::ROUND_TO_EVEN:
+      return inc_teven;
+    case ieee_floatt::ROUND_TO_AWAY:
+      return inc_taway;
+    case ieee_floatt::ROUND_TO_PLUS_INF:
+      return inc_pos;
+    case ieee_floatt::ROUND_TO_MINUS_INF:
+      return inc_neg;
+    default:
+      return nil_1;
+    }
+  }
+
   smt_astt rm_is_to_neg = mk_is_rm(rm, ieee_floatt::ROUND_TO_MINUS_INF);
   smt_astt rm_is_to_pos = mk_is_rm(rm, ieee_floatt::ROUND_TO_PLUS_INF);
   smt_astt rm_is_away = mk_is_rm(rm, ieee_floatt::ROUND_TO_AWAY);
@@ -2120,6 +2223,10 @@ smt_astt fp_convt::mk_rounding_decision(
 
 smt_astt fp_convt::mk_is_rm(smt_astt &rme, ieee_floatt::rounding_modet rm)
 {
+  ieee_floatt::rounding_modet known_rm;
+  if(get_const_rm(rme, known_rm))
+    return ctx->mk_smt_bool(known_rm == rm);
+
   smt_astt rm_num = ctx->mk_smt_bv(rm, 3);
   switch(rm)
   {
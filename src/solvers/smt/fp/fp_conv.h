@@ -1,6 +1,9 @@
 #ifndef SOLVERS_SMT_FP_CONV_H_
 #define SOLVERS_SMT_FP_CONV_H_
 
+#include <map>
+#include <tuple>
+#include <unordered_map>
 #include <solvers/smt/smt_ast.h>
 #include <solvers/smt/smt_sort.h>
 
@@ -219,9 +222,42 @@ public:
    */
   virtual smt_astt mk_from_fp_to_bv(smt_astt op);
 
+  /** Called by smt_convt when a context is popped. Everything memoised below
+   *  is keyed on ASTs, which the pop may have freed, so it all goes. */
+  virtual void pop_fp_ctx();
+
 private:
   smt_convt *ctx;
 
+  // Memoisation of the bit-level encoding: the same operands, and the same
+  // rounding mode, recur a lot across SSA steps, and every arithmetic
+  // operation is a large circuit.
+  enum fp_opt
+  {
+    FP_ADD,
+    FP_MUL,
+    FP_DIV,
+    FP_FMA,
+    FP_SQRT,
+    FP_NEG
+  };
+  typedef std::tuple<fp_opt, smt_astt, smt_astt, smt_astt, smt_astt> op_keyt;
+  std::map<op_keyt, smt_astt> op_cache;
+
+  struct unpackedt
+  {
+    smt_astt sgn, sig, exp, lz;
+  };
+  // Indexed by whether the significand was normalized.
+  std::unordered_map<smt_astt, unpackedt> unpack_cache[2];
+
+  // Rounding modes we built from a constant, so that their circuits can be
+  // specialised to that mode.
+  std::map<ieee_floatt::rounding_modet, smt_astt> rm_asts;
+  std::unordered_map<smt_astt, ieee_floatt::rounding_modet> const_rms;
+
+  bool get_const_rm(smt_astt rm, ieee_floatt::rounding_modet &out) const;
+
   void unpack(
     smt_astt &src,
     smt_astt &sgn,
@@ -51,6 +51,16 @@ public:
 
   virtual void add_array_constraints_for_solving(){};
 
+  /** Check the current satisfying assignment against any array axioms that
+   *  were deferred rather than encoded up front, and assert those it
+   *  violates. Only meaningful straight after a satisfiable dec_solve.
+   *  @return True if constraints were added, and the formula must be solved
+   *          again. */
+  virtual bool refine_array_constraints()
+  {
+    return false;
+  }
+
   virtual void push_array_ctx(){};
   virtual void pop_array_ctx(){};
 
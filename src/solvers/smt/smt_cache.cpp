@@ -0,0 +1,28 @@
+#include <solvers/smt/smt_cache.h>
+
+std::size_t smt_cachet::bytes() const
+{
+  // Each hash node holds a next pointer, the key / value pair and the hash.
+  std::size_t node_overhead = sizeof(void *) + sizeof(std::size_t);
+  std::size_t total =
+    by_expr.size() * (node_overhead + sizeof(expr2tc) + sizeof(smt_astt)) +
+    by_node.size() * (node_overhead + sizeof(expr2t *) + sizeof(smt_astt)) +
+    (by_expr.bucket_count() + by_node.bucket_count()) * sizeof(void *);
+
+  for(const auto &level : levels)
+    total += sizeof(level) + level.capacity() * sizeof(expr2tc);
+
+  return total;
+}
+
+void smt_cachet::print_stats(std::ostream &out) const
+{
+  uint64_t lookups =
+    stats.identity_hits + stats.structural_hits + stats.misses;
+  uint64_t hits = stats.identity_hits + stats.structural_hits;
+
+  out << "SMT cache: " << lookups << " lookups, " << hits << " hits ("
+      << stats.identity_hits << " by node identity), " << stats.misses
+      << " misses; " << size() << " entries (peak " << stats.peak_entries
+      << "), about " << bytes() / 1024 << " KiB";
+}
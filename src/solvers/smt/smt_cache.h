@@ -0,0 +1,119 @@
+#ifndef _ESBMC_SOLVERS_SMT_SMT_CACHE_H_
+#define _ESBMC_SOLVERS_SMT_SMT_CACHE_H_
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include <solvers/smt/smt_ast.h>
+#include <util/irep2.h>
+
+/** @file smt_cache.h
+ *  Cache of expressions already converted by smt_convt.
+ */
+
+/** Maps converted expressions to their SMT ASTs, scoped by context level.
+ *  Every entry belongs to the level it was inserted at, and each level keeps
+ *  the list of keys inserted at it. Popping a level erases exactly those keys
+ *  from both indexes, one by one, so neither index needs to be ordered by
+ *  level. The lookup tables themselves are shared by all levels, which keeps
+ *  a lookup to two probes however deep the context stack is.
+ *
+ *  Lookups first try the address of the expression node, which is enough for
+ *  anything hash-consed or simply re-converted from the same SSA step, and
+ *  only then fall back to hashing and comparing the expression structurally.
+ *  The cache holds a reference to every key it indexes, so a node address
+ *  can't be reused by another expression while it is still in here. */
+class smt_cachet
+{
+public:
+  struct statst
+  {
+    uint64_t identity_hits = 0;
+    uint64_t structural_hits = 0;
+    uint64_t misses = 0;
+    std::size_t peak_entries = 0;
+  };
+
+  smt_cachet() : levels(1)
+  {
+  }
+
+  /** Fetch the AST an expression was converted to, or nullptr if it has not
+   *  been converted at any live level. */
+  smt_astt find(const expr2tc &expr)
+  {
+    auto pit = by_node.find(expr.get());
+    if(pit != by_node.end())
+    {
+      stats.identity_hits++;
+      return pit->second;
+    }
+
+    auto it = by_expr.find(expr);
+    if(it != by_expr.end())
+    {
+      stats.structural_hits++;
+      return it->second;
+    }
+
+    stats.misses++;
+    return nullptr;
+  }
+
+  /** Record expr as converted to ast at the innermost level. An expression
+   *  that is already cached keeps its existing AST. */
+  void insert(const expr2tc &expr, smt_astt ast)
+  {
+    if(!by_expr.emplace(expr, ast).second)
+      return;
+
+    by_node.emplace(expr.get(), ast);
+    levels.back().push_back(expr);
+    if(by_expr.size() > stats.peak_entries)
+      stats.peak_entries = by_expr.size();
+  }
+
+  void push_level()
+  {
+    levels.emplace_back();
+  }
+
+  /** Forget everything inserted since the matching push_level. Costs one
+   *  erase per entry of the popped level. */
+  void pop_level()
+  {
+    assert(levels.size() > 1);
+    for(const expr2tc &e : levels.back())
+    {
+      by_node.erase(e.get());
+      by_expr.erase(e);
+    }
+    levels.pop_back();
+  }
+
+  std::size_t size() const
+  {
+    return by_expr.size();
+  }
+
+  const statst &get_stats() const
+  {
+    return stats;
+  }
+
+  /** Approximate memory held by the cache itself: index nodes, buckets and
+   *  per-level key lists, but not the expressions or ASTs they refer to. */
+  std::size_t bytes() const;
+
+  void print_stats(std::ostream &out) const;
+
+protected:
+  std::unordered_map<expr2tc, smt_astt, irep2_hash> by_expr;
+  std::unordered_map<const expr2t *, smt_astt> by_node;
+  /** Keys inserted at each live level, outermost first. */
+  std::vector<std::vector<expr2tc>> levels;
+  statst stats;
+};
+
+#endif /* _ESBMC_SOLVERS_SMT_SMT_CACHE_H_ */
@@ -180,6 +180,7 @@ void smt_convt::push_ctx()
   renumber_map.push_back(renumber_map.back());
 
   live_asts_sizes.push_back(live_asts.size());
+  smt_cache.push_level();
 
   ctx_level++;
 }
@@ -188,8 +189,7 @@ void smt_convt::pop_ctx()
 {
   // Erase everything in caches added in the current context level. Everything
   // before the push is going to disappear.
-  smt_cachet::nth_index<1>::type &cache_numindex = smt_cache.get<1>();
-  cache_numindex.erase(ctx_level);
+  smt_cache.pop_level();
   pointer_logic.pop_back();
   addr_space_sym_num.pop_back();
   addr_space_data.pop_back();
@@ -208,6 +208,10 @@ void smt_convt::pop_ctx()
 
   array_api->pop_array_ctx();
   tuple_api->pop_tuple_ctx();
+  fp_api->pop_fp_ctx();
+
+  // The model, and possibly some of the asts its values were keyed on, is gone
+  clear_model_values();
 }
 
 smt_astt smt_convt::invert_ast(smt_astt a)
@@ -241,17 +245,15 @@ smt_astt smt_convt::convert_assign(const expr2tc &expr)
   // IMPORTANT: the cache is now a fundamental part of how some flatteners work,
   // in that one can choose to create a set of expressions and their ASTs, then
   // store them in the cache, rather than have a more sophisticated conversion.
-  smt_cache_entryt e = {eq.side_1, side2, ctx_level};
-  smt_cache.insert(e);
+  smt_cache.insert(eq.side_1, side2);
 
   return side2;
 }
 
 smt_astt smt_convt::convert_ast(const expr2tc &expr)
 {
-  smt_cachet::const_iterator cache_result = smt_cache.find(expr);
-  if(cache_result != smt_cache.end())
-    return (cache_result->ast);
+  if(smt_astt cached = smt_cache.find(expr))
+    return cached;
   std::vector<smt_astt> args;
   args.reserve(expr->get_num_sub_exprs());
 
@@ -1089,8 +1091,7 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
     abort();
   }
 
-  struct smt_cache_entryt entry = {expr, a, ctx_level};
-  smt_cache.insert(entry);
+  smt_cache.insert(expr, a);
 
   return a;
 }
@@ -2007,6 +2008,17 @@ type2tc smt_convt::get_flattened_array_subtype(const type2tc &type)
   return type_rec;
 }
 
+smt_convt::resultt smt_convt::solve()
+{
+  clear_model_values();
+
+  resultt res = dec_solve();
+  while(res == P_SATISFIABLE && array_api->refine_array_constraints())
+    res = dec_solve();
+
+  return res;
+}
+
 void smt_convt::pre_solve()
 {
   // NB: always perform tuple constraint adding first, as it covers tuple
@@ -2017,6 +2029,68 @@ void smt_convt::pre_solve()
 }
 
 expr2tc smt_convt::get(const expr2tc &expr)
+{
+  if(is_constant_number(expr))
+    return expr;
+
+  auto it = model_values.find(expr);
+  if(it != model_values.end())
+    return it->second;
+
+  expr2tc res = get_model_value(expr);
+  model_values.emplace(expr, res);
+  return res;
+}
+
+void smt_convt::memoise_model_values(const std::vector<expr2tc> &exprs)
+{
+  for(const expr2tc &e : exprs)
+  {
+    if(is_nil_expr(e) || is_constant_expr(e))
+      continue;
+
+    try
+    {
+      get(e);
+    }
+    catch(type2t::symbolic_type_excp *)
+    {
+      // Not cached: get() will run into this again when it's asked for e.
+    }
+  }
+}
+
+std::vector<tvt> smt_convt::l_get_each(const std::vector<smt_astt> &asts)
+{
+  std::vector<tvt> res;
+  res.reserve(asts.size());
+  for(smt_astt a : asts)
+    res.push_back(l_get(a));
+  return res;
+}
+
+void smt_convt::clear_model_values()
+{
+  model_values.clear();
+  model_array_elems.clear();
+}
+
+expr2tc smt_convt::get_model_array_elem(
+  smt_astt array,
+  uint64_t index,
+  const type2tc &subtype)
+{
+  auto key = std::make_pair(array, index);
+  auto it = model_array_elems.find(key);
+  if(it != model_array_elems.end())
+    return it->second;
+
+  expr2tc elem = array_api->get_array_elem(array, index, subtype);
+  model_array_elems.emplace(key, elem);
+  return elem;
+}
+
+expr2tc smt_convt::get_model_value(const expr2tc &expr)
 {
   if(is_constant_number(expr))
     return expr;
@@ -2060,7 +2134,7 @@ expr2tc smt_convt::get(const expr2tc &expr)
       smt_astt array = convert_ast(src_value);
 
       // Retrieve the element
-      res = array_api->get_array_elem(
+      res = get_model_array_elem(
         array,
         to_constant_int2t(idx).value.to_uint64(),
         get_flattened_array_subtype(res->type));
@@ -2228,7 +2302,7 @@ expr2tc smt_convt::get_array(const expr2tc &expr)
 
   for(size_t i = 0; i < (1ULL << w); i++)
   {
-    fields.push_back(array_api->get_array_elem(array, i, ar.subtype));
+    fields.push_back(get_model_array_elem(array, i, ar.subtype));
   }
 
   return constant_array2tc(arr_type, fields);
@@ -1,13 +1,10 @@
 #ifndef _ESBMC_PROP_SMT_SMT_CONV_H_
 #define _ESBMC_PROP_SMT_SMT_CONV_H_
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index_container.hpp>
 #include <cstdint>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/pointer_logic.h>
+#include <solvers/smt/smt_cache.h>
 #include <util/irep2_utils.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -174,6 +171,12 @@ public:
   virtual void push_ctx();
   /** Pop one context on the SMT assertion stack. */
   virtual void pop_ctx();
+  /** Whether push_ctx / pop_ctx also retract assertions in the backend, as
+   *  opposed to only scoping the conversion caches. */
+  virtual bool can_pop_assertions() const
+  {
+    return false;
+  }
 
   /** Main interface to SMT conversion.
    *  Takes one expression, and converts it into the underlying SMT solver,
@@ -244,6 +247,12 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Solve the formula, as dec_solve does, but also refine it against the
+   *  model for as long as the array api has deferred constraints that the
+   *  model violates. Callers wanting a final answer should use this.
+   *  @return Result code of the last call to the solver. */
+  resultt solve();
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
@@ -277,6 +286,16 @@ public:
    *          reason. */
   virtual expr2tc get(const expr2tc &expr);
 
+  /** Memoise the model values of many expressions, ahead of the get() calls
+   *  that will want them. This is not a batched solver query: each distinct
+   *  expression, subexpression and array element is still asked of the
+   *  solver on its own, but only once. get() then answers from the memo,
+   *  until the next solve() or pop_ctx(). Nil and constant expressions are
+   *  skipped, as are those whose value can't be built: get() reports those
+   *  as it would have.
+   *  @param exprs The expressions to memoise the values of. */
+  void memoise_model_values(const std::vector<expr2tc> &exprs);
+
   /** Solver name fetcher. Returns a string naming the solver being used, and
    *  potentially it's version, if available.
    *  @return The name of the solver this smt_convt uses. */
@@ -289,6 +308,11 @@ public:
    *  @return A three-valued return val, of the assignment to a. */
   virtual tvt l_get(smt_astt a);
 
+  /** Call l_get on each of many boolean sorted asts.
+   *  @param asts The boolean sorted asts to fetch the values of.
+   *  @return The assignment to each of asts, in the same order. */
+  std::vector<tvt> l_get_each(const std::vector<smt_astt> &asts);
+
   /** @} */
 
   /** @{
@@ -753,6 +777,16 @@ public:
   /** Given an array expression, attempt to extract its valuation from the
    *  solver model, computing a constant_array2tc by calling get_array_elem. */
   expr2tc get_array(const expr2tc &expr);
+  /** Fetch one element of an array from the model, remembering it for the
+   *  rest of this model. */
+  expr2tc get_model_array_elem(
+    smt_astt array,
+    uint64_t index,
+    const type2tc &subtype);
+  /** Work out the value of expr in the model; get() memoises this. */
+  expr2tc get_model_value(const expr2tc &expr);
+  /** Forget every value fetched from the current model. */
+  void clear_model_values();
 
   void delete_all_asts();
 
@@ -760,35 +794,22 @@ public:
 
   // Types
 
-  // Type for (optional) AST cache
-
-  struct smt_cache_entryt
-  {
-    const expr2tc val;
-    smt_astt ast;
-    unsigned int level;
-  };
-
-  typedef boost::multi_index_container<
-    smt_cache_entryt,
-    boost::multi_index::indexed_by<
-      boost::multi_index::hashed_unique<
-        BOOST_MULTI_INDEX_MEMBER(smt_cache_entryt, const expr2tc, val)>,
-      boost::multi_index::ordered_non_unique<
-        BOOST_MULTI_INDEX_MEMBER(smt_cache_entryt, unsigned int, level),
-        std::greater<unsigned int>>>>
-    smt_cachet;
-
   typedef std::unordered_map<type2tc, smt_sortt, type2_hash> smt_sort_cachet;
 
   // Members
   /** Number of un-popped context pushes encountered so far. */
   unsigned int ctx_level;
 
-  /** A cache mapping expressions to converted SMT ASTs. */
+  /** A cache mapping expressions to converted SMT ASTs, with one level per
+   *  context push. */
   smt_cachet smt_cache;
   /** A cache of converted type2tc's to smt sorts */
   smt_sort_cachet sort_cache;
+  /** Values fetched from the current model by get(), and the array elements
+   *  fetched along the way, so that counterexample traces, which ask about
+   *  the same variables and arrays over and over, query the solver once. */
+  std::unordered_map<expr2tc, expr2tc, irep2_hash> model_values;
+  std::map<std::pair<smt_astt, uint64_t>, expr2tc> model_array_elems;
   /** Pointer_logict object, which contains some code for formatting how
    *  pointers are displayed in counter-examples. This is a list so that we
    *  can push and pop data when context push/pop operations occur. */
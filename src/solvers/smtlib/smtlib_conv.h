@@ -1,6 +1,10 @@
 #ifndef _ESBMC_SOLVERS_SMTLIB_SMTLIB_CONV_H
 #define _ESBMC_SOLVERS_SMTLIB_SMTLIB_CONV_H
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <list>
 #include <solvers/smt/smt_conv.h>
 #include <string>
@@ -270,6 +274,10 @@ public:
 
   void push_ctx() override;
   void pop_ctx() override;
+  bool can_pop_assertions() const override
+  {
+    return true;
+  }
 
   // Members
   FILE *out_stream;
@@ -155,6 +155,7 @@ smt_convt *create_solver_factory(
   bool node_flat = options.get_bool_option("tuple-node-flattener");
   bool sym_flat = options.get_bool_option("tuple-sym-flattener");
   bool array_flat = options.get_bool_option("array-flattener");
+  bool lazy_arrays = options.get_bool_option("lazy-arrays");
   bool fp_to_bv = options.get_bool_option("fp2bv");
 
   // Pick a tuple flattener to use. If the solver has native support, and no
@@ -177,9 +178,9 @@ smt_convt *create_solver_factory(
   if(array_api != nullptr && !array_flat)
     ctx->set_array_iface(array_api);
   else if(array_flat)
-    ctx->set_array_iface(new array_convt(ctx));
+    ctx->set_array_iface(new array_convt(ctx, lazy_arrays));
   else
-    ctx->set_array_iface(new array_convt(ctx));
+    ctx->set_array_iface(new array_convt(ctx, lazy_arrays));
 
   if(fp_api == nullptr || fp_to_bv)
     ctx->set_fp_conv(new fp_convt(ctx));
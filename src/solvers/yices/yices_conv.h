@@ -125,6 +125,10 @@ public:
 
   void push_ctx() override;
   void pop_ctx() override;
+  bool can_pop_assertions() const override
+  {
+    return true;
+  }
 
   smt_astt
   convert_array_of(smt_astt init_val, unsigned long domain_width) override;
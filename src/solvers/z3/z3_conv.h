@@ -39,6 +39,10 @@ public:
 public:
   void push_ctx() override;
   void pop_ctx() override;
+  bool can_pop_assertions() const override
+  {
+    return true;
+  }
   smt_convt::resultt dec_solve() override;
 
   bool get_bool(smt_astt a) override;
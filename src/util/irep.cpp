@@ -25,7 +25,7 @@ void irept::dump() const
 const irept &get_nil_irep()
 {
   if(nil_rep_storage.id().empty()) // initialized?
-    nil_rep_storage.id("nil");
+    nil_rep_storage.id(ID_nil);
   return nil_rep_storage;
 }
 
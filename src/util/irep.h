@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define SHARING
 
 #include <util/dstring.h>
+#include <util/irep_ids.h>
 
 typedef dstring irep_idt;
 typedef dstring irep_namet;
@@ -55,11 +56,11 @@ public:
 
   bool is_nil() const
   {
-    return id() == "nil";
+    return id() == ID_nil;
   }
   bool is_not_nil() const
   {
-    return id() != "nil";
+    return id() != ID_nil;
   }
 
   explicit irept(const irep_idt &_id);
@@ -119,6 +120,31 @@ public:
     return read().data.as_string();
   }
 
+  // Whether this irep shares its data with another one. Shared data is never
+  // written to (writing detaches a private copy first), so for as long as a
+  // copy of this irep is held, shared_data() identifies an unchanging node.
+#ifdef SHARING
+  inline bool is_shared() const
+  {
+    return data != nullptr && data->ref_count > 1;
+  }
+
+  inline const void *shared_data() const
+  {
+    return data;
+  }
+#else
+  inline bool is_shared() const
+  {
+    return false;
+  }
+
+  inline const void *shared_data() const
+  {
+    return nullptr;
+  }
+#endif
+
   inline void id(const irep_idt &_data)
   {
     write().data = _data;
@@ -1177,7 +1203,7 @@ public:
   void make_nil()
   {
     clear();
-    id("nil");
+    id(ID_nil);
   }
 
   subt &get_sub()
@@ -127,6 +127,9 @@ void type2t::dump() const
 
 size_t type2t::crc() const
 {
+  if(crc_val != 0)
+    return crc_val;
+
   return do_crc();
 }
 
@@ -407,6 +410,9 @@ int expr2t::lt(const expr2t &ref) const
 
 size_t expr2t::crc() const
 {
+  if(crc_val != 0)
+    return crc_val;
+
   return do_crc();
 }
 
@@ -1440,8 +1440,9 @@ T2 *get_pointer(esbmct::something2tc<T1, T2, T3, T4, T5, T6> const &p)
 
 inline bool operator==(const type2tc &a, const type2tc &b)
 {
-  // Handle nil ireps
-  if(is_nil_type(a) && is_nil_type(b))
+  // Shared (or both nil) nodes are trivially equal; this is what makes
+  // comparing hash-consed types cheap.
+  if(a.get() == b.get())
     return true;
   if(is_nil_type(a) || is_nil_type(b))
     return false;
@@ -1474,7 +1475,7 @@ inline bool operator>(const type2tc &a, const type2tc &b)
 
 inline bool operator==(const expr2tc &a, const expr2tc &b)
 {
-  if(is_nil_expr(a) && is_nil_expr(b))
+  if(a.get() == b.get())
     return true;
   if(is_nil_expr(a) || is_nil_expr(b))
     return false;
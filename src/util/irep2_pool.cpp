@@ -0,0 +1,52 @@
+#include <util/irep2_pool.h>
+
+const expr2tc &irep2_poolt::intern(const expr2tc &expr)
+{
+  if(is_nil_expr(expr))
+    return expr;
+
+  // Nodes that are already pooled are found by their memoized crc and the
+  // pointer comparison in operator==, without walking the tree.
+  auto it = exprs.find(expr);
+  if(it != exprs.end())
+    return *it;
+
+  // Pool bottom-up, so that the node we insert only ever points at pooled
+  // operands. Only clone the node if one of them actually gets replaced.
+  bool changed = intern(expr->type).get() != expr->type.get();
+  expr->foreach_operand([this, &changed](const expr2tc &e) {
+    if(intern(e).get() != e.get())
+      changed = true;
+  });
+
+  if(!changed)
+    return *exprs.insert(expr).first;
+
+  expr2tc tmp = expr;
+  tmp->type = intern(tmp->type);
+  tmp->Foreach_operand([this](expr2tc &e) { e = intern(e); });
+  return *exprs.insert(tmp).first;
+}
+
+const type2tc &irep2_poolt::intern(const type2tc &type)
+{
+  if(is_nil_type(type))
+    return type;
+
+  auto it = types.find(type);
+  if(it != types.end())
+    return *it;
+
+  bool changed = false;
+  type->foreach_subtype([this, &changed](const type2tc &t) {
+    if(intern(t).get() != t.get())
+      changed = true;
+  });
+
+  if(!changed)
+    return *types.insert(type).first;
+
+  type2tc tmp = type;
+  tmp->Foreach_subtype([this](type2tc &t) { t = intern(t); });
+  return *types.insert(tmp).first;
+}
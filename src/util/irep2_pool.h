@@ -0,0 +1,50 @@
+#ifndef UTIL_IREP2_POOL_H_
+#define UTIL_IREP2_POOL_H_
+
+/** @file irep2_pool.h
+ *  Hash-consing of irep2 expressions and types.
+ */
+
+#include <unordered_set>
+#include <util/irep2.h>
+
+/** Intern table for expr2tc / type2tc.
+ *  Structurally equal nodes handed to intern() come back as one shared node,
+ *  with all of their operands, types and subtypes interned too. As irep2 is
+ *  copy-on-write, sharing is invisible to callers: anyone modifying an
+ *  interned node detaches their own copy first. Once two exprs come out of
+ *  the same pool, operator== on them is decided by the pointer comparison
+ *  and their hashes are already memoized in crc_val.
+ *
+ *  The pool keeps every node it has seen alive until it is cleared or
+ *  destroyed, so it should be scoped to one symex run rather than made global.
+ */
+class irep2_poolt
+{
+public:
+  /** Fetch the pooled node structurally equal to expr, adding it if there is
+   *  none yet. Nil exprs are returned unchanged.
+   *  @param expr Expression to intern
+   *  @return Reference to the pooled expression, valid while the pool lives */
+  const expr2tc &intern(const expr2tc &expr);
+
+  /** Like intern(const expr2tc &), for types. */
+  const type2tc &intern(const type2tc &type);
+
+  void clear()
+  {
+    exprs.clear();
+    types.clear();
+  }
+
+  std::size_t size() const
+  {
+    return exprs.size() + types.size();
+  }
+
+protected:
+  std::unordered_set<expr2tc, irep2_hash> exprs;
+  std::unordered_set<type2tc, type2_hash> types;
+};
+
+#endif /* UTIL_IREP2_POOL_H_ */
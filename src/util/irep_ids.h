@@ -0,0 +1,71 @@
+#ifndef UTIL_IREP_IDS_H
+#define UTIL_IREP_IDS_H
+
+#include <util/dstring.h>
+
+// Names that string_containert interns first, in this order, right after the
+// empty string. Their string container numbers are therefore known at compile
+// time, and the ID_ constants below can be compared against without ever
+// touching the container. Append only; the order is the numbering.
+#define IREP_WELL_KNOWN_IDS(X)                                                 \
+  X(nil, "nil")                                                                \
+  X(symbol, "symbol")                                                          \
+  X(constant, "constant")                                                      \
+  X(type, "type")                                                              \
+  X(code, "code")                                                              \
+  X(statement, "statement")                                                    \
+  X(identifier, "identifier")                                                  \
+  X(value, "value")                                                            \
+  X(operands, "operands")                                                      \
+  X(width, "width")                                                            \
+  X(pointer, "pointer")                                                        \
+  X(array, "array")                                                            \
+  X(incomplete_array, "incomplete_array")                                      \
+  X(struct, "struct")                                                          \
+  X(incomplete_struct, "incomplete_struct")                                    \
+  X(union, "union")                                                            \
+  X(incomplete_union, "incomplete_union")                                      \
+  X(c_enum, "c_enum")                                                          \
+  X(incomplete_c_enum, "incomplete_c_enum")                                    \
+  X(empty, "empty")                                                            \
+  X(bool, "bool")                                                              \
+  X(signedbv, "signedbv")                                                      \
+  X(unsignedbv, "unsignedbv")                                                  \
+  X(fixedbv, "fixedbv")                                                        \
+  X(floatbv, "floatbv")                                                        \
+  X(member, "member")                                                          \
+  X(index, "index")                                                            \
+  X(dereference, "dereference")                                                \
+  X(address_of, "address_of")                                                  \
+  X(typecast, "typecast")                                                      \
+  X(sideeffect, "sideeffect")                                                  \
+  X(function_call, "function_call")                                            \
+  X(assign, "assign")                                                          \
+  X(block, "block")                                                            \
+  X(if, "if")                                                                  \
+  X(and, "and")                                                                \
+  X(or, "or")                                                                  \
+  X(not, "not")                                                                \
+  X(equal, "=")                                                                \
+  X(notequal, "notequal")                                                      \
+  X(plus, "+")                                                                 \
+  X(minus, "-")                                                                \
+  X(mult, "*")                                                                 \
+  X(div, "/")                                                                  \
+  X(string_constant, "string-constant")
+
+enum irep_id_no : unsigned
+{
+  ID_NO_empty_string = 0,
+#define IREP_ID_NO(id, str) ID_NO_##id,
+  IREP_WELL_KNOWN_IDS(IREP_ID_NO)
+#undef IREP_ID_NO
+  ID_NO_last
+};
+
+#define IREP_ID_CONSTANT(id, str)                                              \
+  constexpr dstring ID_##id = dstring::make_from_table_index(ID_NO_##id);
+IREP_WELL_KNOWN_IDS(IREP_ID_CONSTANT)
+#undef IREP_ID_CONSTANT
+
+#endif
@@ -164,18 +164,12 @@ dstring irep_serializationt::read_string(std::istream &in)
 
 void irep_serializationt::write_string_ref(std::ostream &out, const dstring &s)
 {
-  unsigned id = s.get_no();
-  if(id >= ireps_container.string_map.size())
-    ireps_container.string_map.resize(id + 1, false);
+  auto res = ireps_container.string_map.emplace(
+    s.get_no(), ireps_container.string_map.size());
+  write_long(out, res.first->second);
 
-  if(ireps_container.string_map[id])
-    write_long(out, id);
-  else
-  {
-    ireps_container.string_map[id] = true;
-    write_long(out, id);
+  if(res.second)
     write_string(out, s.as_string());
-  }
 }
 
 irep_idt irep_serializationt::read_string_ref(std::istream &in)
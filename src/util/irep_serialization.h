@@ -12,6 +12,7 @@ Date: May 2007
 #define IREP_SERIALIZATION_H_
 
 #include <map>
+#include <unordered_map>
 #include <util/irep.h>
 
 void write_long(std::ostream &, unsigned);
@@ -66,7 +67,9 @@ public:
     typedef std::vector<irept> irepts_on_writet;
     irepts_on_writet ireps_on_write;
 
-    typedef std::vector<bool> string_mapt;
+    // Strings are numbered in the order they are first written, so that
+    // the reader's table stays as small as the set of strings it meets.
+    typedef std::unordered_map<unsigned, unsigned> string_mapt;
     string_mapt string_map;
 
     typedef std::vector<std::pair<bool, dstring>> string_rev_mapt;
@@ -23,6 +23,14 @@ public:
   virtual bool
   parse(const std::string &path, message_handlert &message_handler) = 0;
 
+  // whether parse() may run concurrently with the parse() of other language
+  // objects; it must then only touch state of its own
+
+  virtual bool parse_is_thread_safe() const
+  {
+    return false;
+  }
+
   // add external dependencies of a given module to set
 
   virtual void dependencies()
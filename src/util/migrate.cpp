@@ -1,3 +1,4 @@
+#include <unordered_map>
 #include <util/c_types.h>
 #include <util/config.h>
 #include <util/irep2_utils.h>
@@ -338,15 +339,12 @@ void real_migrate_type(
   }
 }
 
-void migrate_type(
+static void pool_migrate_type(
   const typet &type,
   type2tc &new_type_ref,
   const namespacet *ns,
   bool cache)
 {
-  if(!cache)
-    return real_migrate_type(type, new_type_ref, ns, cache);
-
   if(type.id() == typet::t_bool)
   {
     new_type_ref = type_pool.get_bool();
@@ -449,6 +447,38 @@ void migrate_type(
   }
 }
 
+// Types are copied about far more often than they're built, so most arrive
+// here sharing their data with one that has already been migrated. Finding
+// that by address saves the deep comparisons of a type_pool lookup. The cache
+// holds a copy of each key, which keeps it from being freed or written to.
+static std::unordered_map<const void *, std::pair<typet, type2tc>>
+  migrated_types;
+
+void migrate_type(
+  const typet &type,
+  type2tc &new_type_ref,
+  const namespacet *ns,
+  bool cache)
+{
+  if(!cache)
+    return real_migrate_type(type, new_type_ref, ns, cache);
+
+  // With a namespace, symbol types are followed, giving a different result.
+  if(ns != nullptr || !type.is_shared())
+    return pool_migrate_type(type, new_type_ref, ns, cache);
+
+  auto it = migrated_types.find(type.shared_data());
+  if(it != migrated_types.end())
+  {
+    new_type_ref = it->second.second;
+    return;
+  }
+
+  pool_migrate_type(type, new_type_ref, ns, cache);
+  migrated_types.emplace(
+    type.shared_data(), std::make_pair(type, new_type_ref));
+}
+
 static const typet &decide_on_expr_type(const exprt &side1, const exprt &side2)
 {
   // For some arithmetic expr, decide on the result of operating on them.
@@ -776,42 +806,272 @@ static expr2tc flatten_union(const exprt &expr)
   return arr;
 }
 
-void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
+/** The ids migrate_expr dispatches on: expression ids, the types of
+ *  constants and code statements. Everything else is MIG_OTHER. */
+enum migrate_idt : unsigned char
 {
-  type2tc type;
-
-  if(expr.id() == "nil")
-  {
-    new_expr_ref = expr2tc();
-  }
-  else if(expr.id() == irept::id_symbol)
-  {
-    migrate_type(expr.type(), type);
-    new_expr_ref = sym_name_to_symbol(expr.identifier(), type);
-  }
-  else if(expr.id() == "nondet_symbol")
-  {
-    migrate_type(expr.type(), type);
-    new_expr_ref = symbol2tc(type, "nondet$" + expr.identifier().as_string());
-  }
-  else if(
-    expr.id() == irept::id_constant && expr.type().id() != typet::t_pointer &&
-    expr.type().id() != typet::t_bool && expr.type().id() != "c_enum" &&
-    expr.type().id() != typet::t_fixedbv &&
-    expr.type().id() != typet::t_floatbv && expr.type().id() != typet::t_array)
-  {
-    migrate_type(expr.type(), type);
+  MIG_OTHER = 0,
+  MIG_NIL,
+  MIG_SYMBOL,
+  MIG_NONDET_SYMBOL,
+  MIG_TYPECAST,
+  MIG_BITCAST,
+  MIG_NEARBYINT,
+  MIG_STRUCT,
+  MIG_UNION,
+  MIG_STRING_CONSTANT,
+  MIG_ARRAY,
+  MIG_ARRAYOF,
+  MIG_IF,
+  MIG_EQUALITY,
+  MIG_NOTEQUAL,
+  MIG_LT,
+  MIG_GT,
+  MIG_LE,
+  MIG_GE,
+  MIG_NOT,
+  MIG_AND,
+  MIG_OR,
+  MIG_XOR,
+  MIG_IMPLIES,
+  MIG_BITAND,
+  MIG_BITOR,
+  MIG_BITXOR,
+  MIG_BITNAND,
+  MIG_BITNOR,
+  MIG_BITNXOR,
+  MIG_BITNOT,
+  MIG_LSHR,
+  MIG_UNARY_MINUS,
+  MIG_ABS,
+  MIG_PLUS,
+  MIG_MINUS,
+  MIG_MULT,
+  MIG_DIV,
+  MIG_IEEE_ADD,
+  MIG_IEEE_SUB,
+  MIG_IEEE_MUL,
+  MIG_IEEE_DIV,
+  MIG_IEEE_FMA,
+  MIG_IEEE_SQRT,
+  MIG_MOD,
+  MIG_SHL,
+  MIG_ASHR,
+  MIG_POINTER_OFFSET,
+  MIG_POINTER_OBJECT,
+  MIG_ADDRESS_OF,
+  MIG_BYTE_EXTRACT_LITTLE_ENDIAN,
+  MIG_BYTE_EXTRACT_BIG_ENDIAN,
+  MIG_BYTE_UPDATE_LITTLE_ENDIAN,
+  MIG_BYTE_UPDATE_BIG_ENDIAN,
+  MIG_WITH,
+  MIG_MEMBER,
+  MIG_INDEX,
+  MIG_MEMORY_LEAK,
+  MIG_ISNAN,
+  MIG_WIDTH,
+  MIG_SAME_OBJECT,
+  MIG_INVALID_OBJECT,
+  MIG_UNARY_PLUS,
+  MIG_OVERFLOW_PLUS,
+  MIG_OVERFLOW_MINUS,
+  MIG_OVERFLOW_MULT,
+  MIG_OVERFLOW_DIV,
+  MIG_OVERFLOW_MOD,
+  MIG_OVERFLOW_SHL,
+  MIG_OVERFLOW_UNARY_MINUS,
+  MIG_UNKNOWN,
+  MIG_INVALID,
+  MIG_NULL_OBJECT,
+  MIG_DYNAMIC_OBJECT,
+  MIG_DEREFERENCE,
+  MIG_VALID_OBJECT,
+  MIG_DEALLOCATED_OBJECT,
+  MIG_DYNAMIC_SIZE,
+  MIG_SIDEEFFECT,
+  MIG_CODE,
+  MIG_ASSIGN,
+  MIG_DECL,
+  MIG_DEAD,
+  MIG_PRINTF,
+  MIG_EXPRESSION,
+  MIG_RETURN,
+  MIG_FREE,
+  MIG_CPP_DELETE_ARRAY,
+  MIG_CPP_DELETE,
+  MIG_OBJECT_DESCRIPTOR,
+  MIG_FUNCTION_CALL,
+  MIG_INVALID_POINTER,
+  MIG_SKIP,
+  MIG_GOTO,
+  MIG_COMMA,
+  MIG_ASM,
+  MIG_CPP_THROW,
+  MIG_THROW_DECL,
+  MIG_ISINF,
+  MIG_ISNORMAL,
+  MIG_ISFINITE,
+  MIG_SIGNBIT,
+  MIG_POPCOUNT,
+  MIG_BSWAP,
+  MIG_CONCAT,
+  MIG_EXTRACT,
+  MIG_CONSTANT,
+  MIG_C_ENUM,
+  MIG_BOOL,
+  MIG_POINTER,
+  MIG_FIXEDBV,
+  MIG_FLOATBV,
+};
+
+static migrate_idt migrate_id(const irep_idt &id)
+{
+  // Indexed by string container number, so that classifying an id costs an
+  // array load instead of a string comparison against every candidate.
+  static const std::vector<migrate_idt> table = [] {
+    const std::pair<irep_idt, migrate_idt> ids[] = {
+      {"nil", MIG_NIL},
+      {irept::id_symbol, MIG_SYMBOL},
+      {"nondet_symbol", MIG_NONDET_SYMBOL},
+      {exprt::typecast, MIG_TYPECAST},
+      {"bitcast", MIG_BITCAST},
+      {"nearbyint", MIG_NEARBYINT},
+      {typet::t_struct, MIG_STRUCT},
+      {typet::t_union, MIG_UNION},
+      {"string-constant", MIG_STRING_CONSTANT},
+      {typet::t_array, MIG_ARRAY},
+      {exprt::arrayof, MIG_ARRAYOF},
+      {exprt::i_if, MIG_IF},
+      {exprt::equality, MIG_EQUALITY},
+      {exprt::notequal, MIG_NOTEQUAL},
+      {exprt::i_lt, MIG_LT},
+      {exprt::i_gt, MIG_GT},
+      {exprt::i_le, MIG_LE},
+      {exprt::i_ge, MIG_GE},
+      {exprt::i_not, MIG_NOT},
+      {exprt::i_and, MIG_AND},
+      {exprt::i_or, MIG_OR},
+      {exprt::i_xor, MIG_XOR},
+      {exprt::implies, MIG_IMPLIES},
+      {exprt::i_bitand, MIG_BITAND},
+      {exprt::i_bitor, MIG_BITOR},
+      {exprt::i_bitxor, MIG_BITXOR},
+      {exprt::i_bitnand, MIG_BITNAND},
+      {exprt::i_bitnor, MIG_BITNOR},
+      {exprt::i_bitnxor, MIG_BITNXOR},
+      {exprt::i_bitnot, MIG_BITNOT},
+      {exprt::i_lshr, MIG_LSHR},
+      {"unary-", MIG_UNARY_MINUS},
+      {exprt::abs, MIG_ABS},
+      {exprt::plus, MIG_PLUS},
+      {exprt::minus, MIG_MINUS},
+      {exprt::mult, MIG_MULT},
+      {exprt::div, MIG_DIV},
+      {"ieee_add", MIG_IEEE_ADD},
+      {"ieee_sub", MIG_IEEE_SUB},
+      {"ieee_mul", MIG_IEEE_MUL},
+      {"ieee_div", MIG_IEEE_DIV},
+      {"ieee_fma", MIG_IEEE_FMA},
+      {"ieee_sqrt", MIG_IEEE_SQRT},
+      {exprt::mod, MIG_MOD},
+      {exprt::i_shl, MIG_SHL},
+      {exprt::i_ashr, MIG_ASHR},
+      {"pointer_offset", MIG_POINTER_OFFSET},
+      {"pointer_object", MIG_POINTER_OBJECT},
+      {exprt::id_address_of, MIG_ADDRESS_OF},
+      {"byte_extract_little_endian", MIG_BYTE_EXTRACT_LITTLE_ENDIAN},
+      {"byte_extract_big_endian", MIG_BYTE_EXTRACT_BIG_ENDIAN},
+      {"byte_update_little_endian", MIG_BYTE_UPDATE_LITTLE_ENDIAN},
+      {"byte_update_big_endian", MIG_BYTE_UPDATE_BIG_ENDIAN},
+      {"with", MIG_WITH},
+      {exprt::member, MIG_MEMBER},
+      {exprt::index, MIG_INDEX},
+      {"memory-leak", MIG_MEMORY_LEAK},
+      {exprt::isnan, MIG_ISNAN},
+      {irept::a_width, MIG_WIDTH},
+      {"same-object", MIG_SAME_OBJECT},
+      {"invalid-object", MIG_INVALID_OBJECT},
+      {"unary+", MIG_UNARY_PLUS},
+      {"overflow-+", MIG_OVERFLOW_PLUS},
+      {"overflow--", MIG_OVERFLOW_MINUS},
+      {"overflow-*", MIG_OVERFLOW_MULT},
+      {"overflow-/", MIG_OVERFLOW_DIV},
+      {"overflow-mod", MIG_OVERFLOW_MOD},
+      {"overflow-shl", MIG_OVERFLOW_SHL},
+      {"overflow-unary-", MIG_OVERFLOW_UNARY_MINUS},
+      {"unknown", MIG_UNKNOWN},
+      {"invalid", MIG_INVALID},
+      {"NULL-object", MIG_NULL_OBJECT},
+      {"dynamic_object", MIG_DYNAMIC_OBJECT},
+      {irept::id_dereference, MIG_DEREFERENCE},
+      {"valid_object", MIG_VALID_OBJECT},
+      {"deallocated_object", MIG_DEALLOCATED_OBJECT},
+      {"dynamic_size", MIG_DYNAMIC_SIZE},
+      {"sideeffect", MIG_SIDEEFFECT},
+      {irept::id_code, MIG_CODE},
+      {"assign", MIG_ASSIGN},
+      {"decl", MIG_DECL},
+      {"dead", MIG_DEAD},
+      {"printf", MIG_PRINTF},
+      {"expression", MIG_EXPRESSION},
+      {"return", MIG_RETURN},
+      {"free", MIG_FREE},
+      {"cpp_delete[]", MIG_CPP_DELETE_ARRAY},
+      {"cpp_delete", MIG_CPP_DELETE},
+      {"object_descriptor", MIG_OBJECT_DESCRIPTOR},
+      {"function_call", MIG_FUNCTION_CALL},
+      {"invalid-pointer", MIG_INVALID_POINTER},
+      {"skip", MIG_SKIP},
+      {"goto", MIG_GOTO},
+      {"comma", MIG_COMMA},
+      {"asm", MIG_ASM},
+      {"cpp-throw", MIG_CPP_THROW},
+      {"throw-decl", MIG_THROW_DECL},
+      {"isinf", MIG_ISINF},
+      {"isnormal", MIG_ISNORMAL},
+      {"isfinite", MIG_ISFINITE},
+      {"signbit", MIG_SIGNBIT},
+      {"popcount", MIG_POPCOUNT},
+      {"bswap", MIG_BSWAP},
+      {"concat", MIG_CONCAT},
+      {"extract", MIG_EXTRACT},
+      {irept::id_constant, MIG_CONSTANT},
+      {"c_enum", MIG_C_ENUM},
+      {typet::t_bool, MIG_BOOL},
+      {typet::t_pointer, MIG_POINTER},
+      {typet::t_fixedbv, MIG_FIXEDBV},
+      {typet::t_floatbv, MIG_FLOATBV},
+    };
+
+    std::vector<migrate_idt> t;
+    for(const auto &it : ids)
+    {
+      unsigned no = it.first.get_no();
+      if(no >= t.size())
+        t.resize(no + 1, MIG_OTHER);
+      assert(t[no] == MIG_OTHER);
+      t[no] = it.second;
+    }
+    return t;
+  }();
+
+  unsigned no = id.get_no();
+  return no < table.size() ? table[no] : MIG_OTHER;
+}
 
-    bool is_signed = false;
-    if(type->type_id == type2t::signedbv_id)
-      is_signed = true;
+static void migrate_expr_failed(const exprt &expr)
+{
+  expr.dump();
+  throw new std::string("migrate expr failed");
+}
 
-    BigInt val = binary2bigint(expr.value(), is_signed);
+static void migrate_constant(const exprt &expr, expr2tc &new_expr_ref)
+{
+  type2tc type;
 
-    expr2t *new_expr = new constant_int2t(type, val);
-    new_expr_ref = expr2tc(new_expr);
-  }
-  else if(expr.id() == irept::id_constant && expr.type().id() == "c_enum")
+  switch(migrate_id(expr.type().id()))
+  {
+  case MIG_C_ENUM:
   {
     migrate_type(expr.type(), type);
 
@@ -819,27 +1079,33 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     expr2t *new_expr = new constant_int2t(type, BigInt(enumval));
     new_expr_ref = expr2tc(new_expr);
+    break;
   }
-  else if(expr.id() == irept::id_constant && expr.type().id() == typet::t_bool)
+
+  case MIG_BOOL:
   {
     std::string theval = expr.value().as_string();
     if(theval == "true")
       new_expr_ref = gen_true_expr();
     else
       new_expr_ref = gen_false_expr();
+    break;
   }
-  else if(
-    expr.id() == irept::id_constant && expr.type().id() == typet::t_pointer &&
-    expr.value() == "NULL")
+
+  case MIG_POINTER:
   {
+    if(expr.value() != "NULL")
+      migrate_expr_failed(expr);
+
     // Null is a symbol with pointer type.
     migrate_type(expr.type(), type);
 
     expr2t *new_expr = new symbol2t(type, std::string("NULL"));
     new_expr_ref = expr2tc(new_expr);
+    break;
   }
-  else if(
-    expr.id() == irept::id_constant && expr.type().id() == typet::t_fixedbv)
+
+  case MIG_FIXEDBV:
   {
     migrate_type(expr.type(), type);
 
@@ -847,9 +1113,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     expr2t *new_expr = new constant_fixedbv2t(bv);
     new_expr_ref = expr2tc(new_expr);
+    break;
   }
-  else if(
-    expr.id() == irept::id_constant && expr.type().id() == typet::t_floatbv)
+
+  case MIG_FLOATBV:
   {
     migrate_type(expr.type(), type);
 
@@ -857,8 +1124,232 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     expr2t *new_expr = new constant_floatbv2t(bv);
     new_expr_ref = expr2tc(new_expr);
+    break;
   }
-  else if(expr.id() == exprt::typecast)
+
+  default:
+  {
+    migrate_type(expr.type(), type);
+
+    bool is_signed = false;
+    if(type->type_id == type2t::signedbv_id)
+      is_signed = true;
+
+    BigInt val = binary2bigint(expr.value(), is_signed);
+
+    expr2t *new_expr = new constant_int2t(type, val);
+    new_expr_ref = expr2tc(new_expr);
+    break;
+  }
+  }
+}
+
+static void migrate_code(const exprt &expr, expr2tc &new_expr_ref)
+{
+  type2tc type;
+
+  switch(migrate_id(expr.statement()))
+  {
+  case MIG_ASSIGN:
+  {
+    expr2tc op0, op1;
+    convert_operand_pair(expr, op0, op1);
+    new_expr_ref = expr2tc(new code_assign2t(op0, op1));
+    break;
+  }
+
+  case MIG_DECL:
+  {
+    assert(expr.op0().id() == "symbol");
+    type2tc thetype;
+    irep_idt sym_name;
+    migrate_type(expr.op0().type(), thetype);
+    sym_name = expr.op0().identifier();
+    new_expr_ref = expr2tc(new code_decl2t(thetype, sym_name));
+    break;
+  }
+
+  case MIG_DEAD:
+  {
+    assert(expr.op0().id() == "symbol");
+    type2tc thetype;
+    irep_idt sym_name;
+    migrate_type(expr.op0().type(), thetype);
+    sym_name = expr.op0().identifier();
+    new_expr_ref = expr2tc(new code_dead2t(thetype, sym_name));
+    break;
+  }
+
+  case MIG_PRINTF:
+  {
+    std::vector<expr2tc> ops;
+    for(auto const &it : expr.operands())
+    {
+      expr2tc tmp_op;
+      migrate_expr(it, tmp_op);
+      ops.push_back(tmp_op);
+    }
+    new_expr_ref = expr2tc(new code_printf2t(ops));
+    break;
+  }
+
+  case MIG_EXPRESSION:
+  {
+    assert(expr.operands().size() == 1);
+    expr2tc theop;
+    migrate_expr(expr.op0(), theop);
+    new_expr_ref = expr2tc(new code_expression2t(theop));
+    break;
+  }
+
+  case MIG_RETURN:
+  {
+    expr2tc theop;
+    if(expr.operands().size() == 1)
+      migrate_expr(expr.op0(), theop);
+    else
+      assert(expr.operands().size() == 0);
+    new_expr_ref = expr2tc(new code_return2t(theop));
+    break;
+  }
+
+  case MIG_FREE:
+  {
+    assert(expr.operands().size() == 1);
+    expr2tc theop;
+    migrate_expr(expr.op0(), theop);
+    new_expr_ref = expr2tc(new code_free2t(theop));
+    break;
+  }
+
+  case MIG_CPP_DELETE_ARRAY:
+  {
+    assert(expr.operands().size() == 1);
+    expr2tc theop;
+    migrate_expr(expr.op0(), theop);
+    new_expr_ref = expr2tc(new code_cpp_del_array2t(theop));
+    break;
+  }
+
+  case MIG_CPP_DELETE:
+  {
+    assert(expr.operands().size() == 1);
+    expr2tc theop;
+    migrate_expr(expr.op0(), theop);
+    new_expr_ref = expr2tc(new code_cpp_delete2t(theop));
+    break;
+  }
+
+  case MIG_FUNCTION_CALL:
+  {
+    expr2tc op0, op1;
+    convert_operand_pair(expr, op0, op1);
+
+    std::vector<expr2tc> args;
+    const exprt &irep_args = expr.op2();
+    assert(irep_args.is_not_nil());
+    forall_operands(it, irep_args)
+    {
+      expr2tc tmp;
+      migrate_expr(*it, tmp);
+      args.push_back(tmp);
+    }
+
+    new_expr_ref = expr2tc(new code_function_call2t(op0, op1, args));
+    break;
+  }
+
+  case MIG_SKIP:
+  {
+    new_expr_ref = expr2tc(new code_skip2t(get_empty_type()));
+    break;
+  }
+
+  case MIG_GOTO:
+  {
+    new_expr_ref = expr2tc(new code_goto2t(expr.get("destination")));
+    break;
+  }
+
+  case MIG_ASM:
+  {
+    migrate_type(expr.type(), type);
+    const irep_idt &str = expr.op0().value();
+    new_expr_ref = expr2tc(new code_asm2t(type, str));
+    break;
+  }
+
+  case MIG_CPP_THROW:
+  {
+    // No type,
+    const irept::subt &exceptions_thrown =
+      expr.find("exception_list").get_sub();
+
+    std::vector<irep_idt> expr_list;
+    for(const auto &e_it : exceptions_thrown)
+    {
+      expr_list.push_back(e_it.id());
+    }
+
+    expr2tc operand;
+    if(expr.operands().size() == 1)
+    {
+      migrate_expr(expr.op0(), operand);
+    }
+    else
+    {
+      operand = expr2tc();
+    }
+
+    new_expr_ref = expr2tc(new code_cpp_throw2t(operand, expr_list));
+    break;
+  }
+
+  case MIG_THROW_DECL:
+  {
+    std::vector<irep_idt> expr_list;
+    const irept::subt &exceptions_thrown = expr.find("throw_list").get_sub();
+    for(const auto &e_it : exceptions_thrown)
+    {
+      expr_list.push_back(e_it.id());
+    }
+
+    new_expr_ref = expr2tc(new code_cpp_throw_decl2t(expr_list));
+    break;
+  }
+
+  default:
+    migrate_expr_failed(expr);
+  }
+}
+
+static void migrate_expr_node(const exprt &expr, expr2tc &new_expr_ref)
+{
+  type2tc type;
+
+  switch(migrate_id(expr.id()))
+  {
+  case MIG_NIL:
+  {
+    new_expr_ref = expr2tc();
+    break;
+  }
+
+  case MIG_SYMBOL:
+  {
+    migrate_type(expr.type(), type);
+    new_expr_ref = sym_name_to_symbol(expr.identifier(), type);
+    break;
+  }
+
+  case MIG_NONDET_SYMBOL:
+  {
+    migrate_type(expr.type(), type);
+    new_expr_ref = symbol2tc(type, "nondet$" + expr.identifier().as_string());
+    break;
+  }
+
+  case MIG_TYPECAST:
   {
     assert(expr.op0().id_string() != "");
     migrate_type(expr.type(), type);
@@ -877,8 +1368,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     typecast2t *t = new typecast2t(type, old_expr, rounding_mode);
     new_expr_ref = expr2tc(t);
+    break;
   }
-  else if(expr.id() == "bitcast")
+
+  case MIG_BITCAST:
   {
     assert(expr.op0().id_string() != "");
     migrate_type(expr.type(), type);
@@ -888,8 +1381,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitcast2t *t = new bitcast2t(type, old_expr);
     new_expr_ref = expr2tc(t);
+    break;
   }
-  else if(expr.id() == "nearbyint")
+
+  case MIG_NEARBYINT:
   {
     assert(expr.op0().id_string() != "");
     migrate_type(expr.type(), type);
@@ -908,8 +1403,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     nearbyint2t *t = new nearbyint2t(type, old_expr, rounding_mode);
     new_expr_ref = expr2tc(t);
+    break;
   }
-  else if(expr.id() == typet::t_struct)
+
+  case MIG_STRUCT:
   {
     migrate_type(expr.type(), type);
 
@@ -924,14 +1421,18 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     constant_struct2t *s = new constant_struct2t(type, members);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == typet::t_union)
+
+  case MIG_UNION:
   {
     // Unions are now being transformed into byte arrays at all stages past
     // parsing.
     new_expr_ref = flatten_union(expr);
+    break;
   }
-  else if(expr.id() == "string-constant")
+
+  case MIG_STRING_CONSTANT:
   {
     std::string thestring = expr.value().as_string();
     typet thetype = expr.type();
@@ -942,10 +1443,18 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
     type2tc t = type2tc(new string_type2t(val.to_int64()));
 
     new_expr_ref = expr2tc(new constant_string2t(t, irep_idt(thestring)));
+    break;
   }
-  else if(
-    (expr.id() == irept::id_constant && expr.type().id() == typet::t_array) ||
-    expr.id() == typet::t_array)
+
+  case MIG_CONSTANT:
+    if(migrate_id(expr.type().id()) != MIG_ARRAY)
+    {
+      migrate_constant(expr, new_expr_ref);
+      break;
+    }
+    /* fallthrough */
+
+  case MIG_ARRAY:
   {
     // Fixed size array.
     migrate_type(expr.type(), type);
@@ -961,8 +1470,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     constant_array2t *a = new constant_array2t(type, members);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::arrayof)
+
+  case MIG_ARRAYOF:
   {
     migrate_type(expr.type(), type);
 
@@ -972,8 +1483,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     constant_array_of2t *a = new constant_array_of2t(type, new_value);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::i_if)
+
+  case MIG_IF:
   {
     migrate_type(expr.type(), type);
 
@@ -984,8 +1497,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     if2t *i = new if2t(type, cond, true_val, false_val);
     new_expr_ref = expr2tc(i);
+    break;
   }
-  else if(expr.id() == exprt::equality)
+
+  case MIG_EQUALITY:
   {
     expr2tc side1, side2;
 
@@ -993,8 +1508,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     equality2t *e = new equality2t(side1, side2);
     new_expr_ref = expr2tc(e);
+    break;
   }
-  else if(expr.id() == exprt::notequal)
+
+  case MIG_NOTEQUAL:
   {
     expr2tc side1, side2;
 
@@ -1002,8 +1519,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     notequal2t *n = new notequal2t(side1, side2);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_lt)
+
+  case MIG_LT:
   {
     expr2tc side1, side2;
 
@@ -1011,8 +1530,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     lessthan2t *n = new lessthan2t(side1, side2);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_gt)
+
+  case MIG_GT:
   {
     expr2tc side1, side2;
     migrate_expr(expr.op0(), side1);
@@ -1020,8 +1541,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     greaterthan2t *n = new greaterthan2t(side1, side2);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_le)
+
+  case MIG_LE:
   {
     expr2tc side1, side2;
 
@@ -1029,8 +1552,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     lessthanequal2t *n = new lessthanequal2t(side1, side2);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_ge)
+
+  case MIG_GE:
   {
     expr2tc side1, side2;
 
@@ -1038,8 +1563,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     greaterthanequal2t *n = new greaterthanequal2t(side1, side2);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_not)
+
+  case MIG_NOT:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc theval;
@@ -1047,8 +1574,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     not2t *n = new not2t(theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_and)
+
+  case MIG_AND:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc side1, side2;
@@ -1062,8 +1591,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     and2t *a = new and2t(side1, side2);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::i_or)
+
+  case MIG_OR:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc side1, side2;
@@ -1078,8 +1609,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     or2t *o = new or2t(side1, side2);
     new_expr_ref = expr2tc(o);
+    break;
   }
-  else if(expr.id() == exprt::i_xor)
+
+  case MIG_XOR:
   {
     assert(expr.type().id() == typet::t_bool);
     assert(expr.operands().size() == 2);
@@ -1089,8 +1622,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     xor2t *x = new xor2t(side1, side2);
     new_expr_ref = expr2tc(x);
+    break;
   }
-  else if(expr.id() == exprt::implies)
+
+  case MIG_IMPLIES:
   {
     assert(expr.type().id() == typet::t_bool);
     assert(expr.operands().size() == 2);
@@ -1100,8 +1635,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     implies2t *i = new implies2t(side1, side2);
     new_expr_ref = expr2tc(i);
+    break;
   }
-  else if(expr.id() == exprt::i_bitand)
+
+  case MIG_BITAND:
   {
     migrate_type(expr.type(), type);
 
@@ -1116,8 +1653,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitand2t *a = new bitand2t(type, side1, side2);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::i_bitor)
+
+  case MIG_BITOR:
   {
     migrate_type(expr.type(), type);
 
@@ -1132,8 +1671,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitor2t *o = new bitor2t(type, side1, side2);
     new_expr_ref = expr2tc(o);
+    break;
   }
-  else if(expr.id() == exprt::i_bitxor)
+
+  case MIG_BITXOR:
   {
     migrate_type(expr.type(), type);
 
@@ -1148,8 +1689,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitxor2t *x = new bitxor2t(type, side1, side2);
     new_expr_ref = expr2tc(x);
+    break;
   }
-  else if(expr.id() == exprt::i_bitnand)
+
+  case MIG_BITNAND:
   {
     migrate_type(expr.type(), type);
 
@@ -1164,8 +1707,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitnand2t *n = new bitnand2t(type, side1, side2);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_bitnor)
+
+  case MIG_BITNOR:
   {
     migrate_type(expr.type(), type);
 
@@ -1180,8 +1725,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitnor2t *o = new bitnor2t(type, side1, side2);
     new_expr_ref = expr2tc(o);
+    break;
   }
-  else if(expr.id() == exprt::i_bitnxor)
+
+  case MIG_BITNXOR:
   {
     migrate_type(expr.type(), type);
 
@@ -1196,8 +1743,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitnxor2t *x = new bitnxor2t(type, side1, side2);
     new_expr_ref = expr2tc(x);
+    break;
   }
-  else if(expr.id() == exprt::i_bitnot)
+
+  case MIG_BITNOT:
   {
     migrate_type(expr.type(), type);
 
@@ -1207,8 +1756,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bitnot2t *n = new bitnot2t(type, value);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::i_lshr)
+
+  case MIG_LSHR:
   {
     migrate_type(expr.type(), type);
 
@@ -1223,8 +1774,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     lshr2t *s = new lshr2t(type, side1, side2);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == "unary-")
+
+  case MIG_UNARY_MINUS:
   {
     migrate_type(expr.type(), type);
 
@@ -1233,8 +1786,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     neg2t *n = new neg2t(type, theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == exprt::abs)
+
+  case MIG_ABS:
   {
     migrate_type(expr.type(), type);
 
@@ -1243,8 +1798,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     abs2t *a = new abs2t(type, theval);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::plus)
+
+  case MIG_PLUS:
   {
     migrate_type(expr.type(), type);
 
@@ -1259,8 +1816,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     add2t *a = new add2t(type, side1, side2);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::minus)
+
+  case MIG_MINUS:
   {
     migrate_type(expr.type(), type);
 
@@ -1275,8 +1834,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     sub2t *s = new sub2t(type, side1, side2);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == exprt::mult)
+
+  case MIG_MULT:
   {
     migrate_type(expr.type(), type);
 
@@ -1291,8 +1852,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     mul2t *s = new mul2t(type, side1, side2);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == exprt::div)
+
+  case MIG_DIV:
   {
     migrate_type(expr.type(), type);
 
@@ -1303,8 +1866,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     div2t *d = new div2t(type, side1, side2);
     new_expr_ref = expr2tc(d);
+    break;
   }
-  else if(expr.id() == "ieee_add")
+
+  case MIG_IEEE_ADD:
   {
     migrate_type(expr.type(), type);
 
@@ -1328,8 +1893,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ieee_add2t *a = new ieee_add2t(type, side1, side2, rm);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == "ieee_sub")
+
+  case MIG_IEEE_SUB:
   {
     migrate_type(expr.type(), type);
 
@@ -1353,8 +1920,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ieee_sub2t *s = new ieee_sub2t(type, side1, side2, rm);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == "ieee_mul")
+
+  case MIG_IEEE_MUL:
   {
     migrate_type(expr.type(), type);
 
@@ -1378,8 +1947,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ieee_mul2t *s = new ieee_mul2t(type, side1, side2, rm);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == "ieee_div")
+
+  case MIG_IEEE_DIV:
   {
     migrate_type(expr.type(), type);
 
@@ -1399,8 +1970,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ieee_div2t *d = new ieee_div2t(type, side1, side2, rm);
     new_expr_ref = expr2tc(d);
+    break;
   }
-  else if(expr.id() == "ieee_fma")
+
+  case MIG_IEEE_FMA:
   {
     migrate_type(expr.type(), type);
 
@@ -1420,8 +1993,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ieee_fma2t *a = new ieee_fma2t(type, v1, v2, v3, rm);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == "ieee_sqrt")
+
+  case MIG_IEEE_SQRT:
   {
     migrate_type(expr.type(), type);
 
@@ -1439,8 +2014,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ieee_sqrt2t *a = new ieee_sqrt2t(type, value, rm);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == exprt::mod)
+
+  case MIG_MOD:
   {
     migrate_type(expr.type(), type);
 
@@ -1451,8 +2028,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     modulus2t *m = new modulus2t(type, side1, side2);
     new_expr_ref = expr2tc(m);
+    break;
   }
-  else if(expr.id() == exprt::i_shl)
+
+  case MIG_SHL:
   {
     migrate_type(expr.type(), type);
 
@@ -1463,8 +2042,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     shl2t *s = new shl2t(type, side1, side2);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == exprt::i_ashr)
+
+  case MIG_ASHR:
   {
     migrate_type(expr.type(), type);
 
@@ -1475,8 +2056,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     ashr2t *a = new ashr2t(type, side1, side2);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(expr.id() == "pointer_offset")
+
+  case MIG_POINTER_OFFSET:
   {
     migrate_type(expr.type(), type);
 
@@ -1485,8 +2068,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     pointer_offset2t *p = new pointer_offset2t(type, theval);
     new_expr_ref = expr2tc(p);
+    break;
   }
-  else if(expr.id() == "pointer_object")
+
+  case MIG_POINTER_OBJECT:
   {
     migrate_type(expr.type(), type);
 
@@ -1495,8 +2080,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     pointer_object2t *p = new pointer_object2t(type, theval);
     new_expr_ref = expr2tc(p);
+    break;
   }
-  else if(expr.id() == exprt::id_address_of)
+
+  case MIG_ADDRESS_OF:
   {
     assert(expr.type().id() == typet::t_pointer);
 
@@ -1507,10 +2094,11 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     address_of2t *a = new address_of2t(type, theval);
     new_expr_ref = expr2tc(a);
+    break;
   }
-  else if(
-    expr.id() == "byte_extract_little_endian" ||
-    expr.id() == "byte_extract_big_endian")
+
+  case MIG_BYTE_EXTRACT_LITTLE_ENDIAN:
+  case MIG_BYTE_EXTRACT_BIG_ENDIAN:
   {
     migrate_type(expr.type(), type);
 
@@ -1523,10 +2111,11 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     byte_extract2t *b = new byte_extract2t(type, side1, side2, big_endian);
     new_expr_ref = expr2tc(b);
+    break;
   }
-  else if(
-    expr.id() == "byte_update_little_endian" ||
-    expr.id() == "byte_update_big_endian")
+
+  case MIG_BYTE_UPDATE_LITTLE_ENDIAN:
+  case MIG_BYTE_UPDATE_BIG_ENDIAN:
   {
     migrate_type(expr.type(), type);
 
@@ -1543,8 +2132,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
     byte_update2t *u =
       new byte_update2t(type, sourceval, offs, update, big_endian);
     new_expr_ref = expr2tc(u);
+    break;
   }
-  else if(expr.id() == "with")
+
+  case MIG_WITH:
   {
     migrate_type(expr.type(), type);
 
@@ -1567,8 +2158,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     with2t *w = new with2t(type, sourcedata, idx, update);
     new_expr_ref = expr2tc(w);
+    break;
   }
-  else if(expr.id() == exprt::member)
+
+  case MIG_MEMBER:
   {
     migrate_type(expr.type(), type);
 
@@ -1577,8 +2170,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     member2t *m = new member2t(type, sourcedata, expr.component_name());
     new_expr_ref = expr2tc(m);
+    break;
   }
-  else if(expr.id() == exprt::index)
+
+  case MIG_INDEX:
   {
     migrate_type(expr.type(), type);
 
@@ -1588,8 +2183,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     index2t *i = new index2t(type, source, index);
     new_expr_ref = expr2tc(i);
+    break;
   }
-  else if(expr.id() == "memory-leak")
+
+  case MIG_MEMORY_LEAK:
   {
     // Memory leaks are in fact selects/indexes.
     migrate_type(expr.type(), type);
@@ -1601,8 +2198,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     index2t *i = new index2t(type, source, index);
     new_expr_ref = expr2tc(i);
+    break;
   }
-  else if(expr.id() == exprt::isnan)
+
+  case MIG_ISNAN:
   {
     assert(expr.operands().size() == 1);
 
@@ -1611,8 +2210,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     isnan2t *i = new isnan2t(val);
     new_expr_ref = expr2tc(i);
+    break;
   }
-  else if(expr.id() == irept::a_width)
+
+  case MIG_WIDTH:
   {
     assert(expr.operands().size() == 1);
     migrate_type(expr.type(), type);
@@ -1620,8 +2221,10 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
     uint64_t thewidth = type->get_width();
     type2tc inttype(new unsignedbv_type2t(config.ansi_c.int_width));
     new_expr_ref = expr2tc(new constant_int2t(inttype, BigInt(thewidth)));
+    break;
   }
-  else if(expr.id() == "same-object")
+
+  case MIG_SAME_OBJECT:
   {
     assert(expr.operands().size() == 2);
     assert(expr.type().id() == typet::t_bool);
@@ -1630,95 +2233,114 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     same_object2t *s = new same_object2t(op0, op1);
     new_expr_ref = expr2tc(s);
+    break;
   }
-  else if(expr.id() == "invalid-object")
+
+  case MIG_INVALID_OBJECT:
   {
     assert(expr.type().id() == "pointer");
     type2tc pointertype(new pointer_type2t(type2tc(new empty_type2t())));
     new_expr_ref = expr2tc(new symbol2t(pointertype, "INVALID"));
+    break;
   }
-  else if(expr.id() == "unary+")
+
+  case MIG_UNARY_PLUS:
   {
     migrate_expr(expr.op0(), new_expr_ref);
+    break;
   }
-  else if(expr.id() == "overflow-+")
+
+  case MIG_OVERFLOW_PLUS:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     expr2tc add = expr2tc(new add2t(op0->type, op0, op1)); // XXX type?
     new_expr_ref = expr2tc(new overflow2t(add));
+    break;
   }
-  else if(expr.id() == "overflow--")
+
+  case MIG_OVERFLOW_MINUS:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     expr2tc sub = expr2tc(new sub2t(op0->type, op0, op1)); // XXX type?
     new_expr_ref = expr2tc(new overflow2t(sub));
+    break;
   }
-  else if(expr.id() == "overflow-*")
+
+  case MIG_OVERFLOW_MULT:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     expr2tc mul = expr2tc(new mul2t(op0->type, op0, op1)); // XXX type?
     new_expr_ref = expr2tc(new overflow2t(mul));
+    break;
   }
-  else if(expr.id() == "overflow-/")
+
+  case MIG_OVERFLOW_DIV:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     expr2tc div = expr2tc(new div2t(op0->type, op0, op1)); // XXX type?
     new_expr_ref = expr2tc(new overflow2t(div));
+    break;
   }
-  else if(expr.id() == "overflow-mod")
+
+  case MIG_OVERFLOW_MOD:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     expr2tc mod = expr2tc(new modulus2t(op0->type, op0, op1)); // XXX type?
     new_expr_ref = expr2tc(new overflow2t(mod));
+    break;
   }
-  else if(expr.id() == "overflow-shl")
+
+  case MIG_OVERFLOW_SHL:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     expr2tc shl = expr2tc(new shl2t(op0->type, op0, op1)); // XXX type?
     new_expr_ref = expr2tc(new overflow2t(shl));
+    break;
   }
-  else if(has_prefix(expr.id_string(), "overflow-typecast-"))
-  {
-    unsigned bits = atoi(expr.id_string().c_str() + 18);
-    expr2tc operand;
-    migrate_expr(expr.op0(), operand);
-    new_expr_ref = expr2tc(new overflow_cast2t(operand, bits));
-  }
-  else if(expr.id() == "overflow-unary-")
+
+  case MIG_OVERFLOW_UNARY_MINUS:
   {
     assert(expr.type().id() == typet::t_bool);
     expr2tc operand;
     migrate_expr(expr.op0(), operand);
     new_expr_ref = expr2tc(new overflow_neg2t(operand));
+    break;
   }
-  else if(expr.id() == "unknown")
+
+  case MIG_UNKNOWN:
   {
     migrate_type(expr.type(), type);
     new_expr_ref = expr2tc(new unknown2t(type));
+    break;
   }
-  else if(expr.id() == "invalid")
+
+  case MIG_INVALID:
   {
     migrate_type(expr.type(), type);
     new_expr_ref = expr2tc(new invalid2t(type));
+    break;
   }
-  else if(expr.id() == "NULL-object")
+
+  case MIG_NULL_OBJECT:
   {
     migrate_type(expr.type(), type);
     new_expr_ref = expr2tc(new null_object2t(type));
+    break;
   }
-  else if(expr.id() == "dynamic_object")
+
+  case MIG_DYNAMIC_OBJECT:
   {
     migrate_type(expr.type(), type);
     expr2tc op0, op1;
@@ -1737,33 +2359,43 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
     }
 
     new_expr_ref = expr2tc(new dynamic_object2t(type, op0, invalid, unknown));
+    break;
   }
-  else if(expr.id() == irept::id_dereference)
+
+  case MIG_DEREFERENCE:
   {
     migrate_type(expr.type(), type);
     expr2tc op0;
     migrate_expr(expr.op0(), op0);
     new_expr_ref = expr2tc(new dereference2t(type, op0));
+    break;
   }
-  else if(expr.id() == "valid_object")
+
+  case MIG_VALID_OBJECT:
   {
     expr2tc op0;
     migrate_expr(expr.op0(), op0);
     new_expr_ref = expr2tc(new valid_object2t(op0));
+    break;
   }
-  else if(expr.id() == "deallocated_object")
+
+  case MIG_DEALLOCATED_OBJECT:
   {
     expr2tc op0;
     migrate_expr(expr.op0(), op0);
     new_expr_ref = expr2tc(new deallocated_obj2t(op0));
+    break;
   }
-  else if(expr.id() == "dynamic_size")
+
+  case MIG_DYNAMIC_SIZE:
   {
     expr2tc op0;
     migrate_expr(expr.op0(), op0);
     new_expr_ref = expr2tc(new dynamic_size2t(op0));
+    break;
   }
-  else if(expr.id() == "sideeffect")
+
+  case MIG_SIDEEFFECT:
   {
     expr2tc operand, thesize;
     type2tc cmt_type, plaintype;
@@ -1848,206 +2480,90 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     new_expr_ref =
       sideeffect2tc(plaintype, operand, thesize, args, cmt_type, t);
+    break;
   }
-  else if(expr.id() == irept::id_code && expr.statement() == "assign")
-  {
-    expr2tc op0, op1;
-    convert_operand_pair(expr, op0, op1);
-    new_expr_ref = expr2tc(new code_assign2t(op0, op1));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "decl")
-  {
-    assert(expr.op0().id() == "symbol");
-    type2tc thetype;
-    irep_idt sym_name;
-    migrate_type(expr.op0().type(), thetype);
-    sym_name = expr.op0().identifier();
-    new_expr_ref = expr2tc(new code_decl2t(thetype, sym_name));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "dead")
-  {
-    assert(expr.op0().id() == "symbol");
-    type2tc thetype;
-    irep_idt sym_name;
-    migrate_type(expr.op0().type(), thetype);
-    sym_name = expr.op0().identifier();
-    new_expr_ref = expr2tc(new code_dead2t(thetype, sym_name));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "printf")
-  {
-    std::vector<expr2tc> ops;
-    for(auto const &it : expr.operands())
-    {
-      expr2tc tmp_op;
-      migrate_expr(it, tmp_op);
-      ops.push_back(tmp_op);
-    }
-    new_expr_ref = expr2tc(new code_printf2t(ops));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "expression")
-  {
-    assert(expr.operands().size() == 1);
-    expr2tc theop;
-    migrate_expr(expr.op0(), theop);
-    new_expr_ref = expr2tc(new code_expression2t(theop));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "return")
-  {
-    expr2tc theop;
-    if(expr.operands().size() == 1)
-      migrate_expr(expr.op0(), theop);
-    else
-      assert(expr.operands().size() == 0);
-    new_expr_ref = expr2tc(new code_return2t(theop));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "free")
-  {
-    assert(expr.operands().size() == 1);
-    expr2tc theop;
-    migrate_expr(expr.op0(), theop);
-    new_expr_ref = expr2tc(new code_free2t(theop));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "cpp_delete[]")
-  {
-    assert(expr.operands().size() == 1);
-    expr2tc theop;
-    migrate_expr(expr.op0(), theop);
-    new_expr_ref = expr2tc(new code_cpp_del_array2t(theop));
-  }
-  else if(expr.id() == irept::id_code && expr.statement() == "cpp_delete")
-  {
-    assert(expr.operands().size() == 1);
-    expr2tc theop;
-    migrate_expr(expr.op0(), theop);
-    new_expr_ref = expr2tc(new code_cpp_delete2t(theop));
-  }
-  else if(expr.id() == "object_descriptor")
+
+  case MIG_CODE:
+    migrate_code(expr, new_expr_ref);
+    break;
+
+  case MIG_OBJECT_DESCRIPTOR:
   {
     migrate_type(expr.op0().type(), type);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     new_expr_ref = expr2tc(new object_descriptor2t(type, op0, op1, 0));
+    break;
   }
-  else if(expr.id() == irept::id_code && expr.statement() == "function_call")
-  {
-    expr2tc op0, op1;
-    convert_operand_pair(expr, op0, op1);
 
-    std::vector<expr2tc> args;
-    const exprt &irep_args = expr.op2();
-    assert(irep_args.is_not_nil());
-    forall_operands(it, irep_args)
-    {
-      expr2tc tmp;
-      migrate_expr(*it, tmp);
-      args.push_back(tmp);
-    }
-
-    new_expr_ref = expr2tc(new code_function_call2t(op0, op1, args));
-  }
-  else if(expr.id() == "invalid-pointer")
+  case MIG_INVALID_POINTER:
   {
     expr2tc op0;
     migrate_expr(expr.op0(), op0);
     new_expr_ref = expr2tc(new invalid_pointer2t(op0));
+    break;
   }
-  else if(expr.id() == "code" && expr.statement() == "skip")
-  {
-    new_expr_ref = expr2tc(new code_skip2t(get_empty_type()));
-  }
-  else if(expr.id() == "code" && expr.statement() == "goto")
-  {
-    new_expr_ref = expr2tc(new code_goto2t(expr.get("destination")));
-  }
-  else if(expr.id() == "comma")
+
+  case MIG_COMMA:
   {
     migrate_type(expr.type(), type);
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     new_expr_ref = expr2tc(new code_comma2t(type, op0, op1));
+    break;
   }
-  else if(expr.id() == "code" && expr.statement() == "asm")
-  {
-    migrate_type(expr.type(), type);
-    const irep_idt &str = expr.op0().value();
-    new_expr_ref = expr2tc(new code_asm2t(type, str));
-  }
-  else if(expr.id() == "code" && expr.statement() == "cpp-throw")
-  {
-    // No type,
-    const irept::subt &exceptions_thrown =
-      expr.find("exception_list").get_sub();
-
-    std::vector<irep_idt> expr_list;
-    for(const auto &e_it : exceptions_thrown)
-    {
-      expr_list.push_back(e_it.id());
-    }
-
-    expr2tc operand;
-    if(expr.operands().size() == 1)
-    {
-      migrate_expr(expr.op0(), operand);
-    }
-    else
-    {
-      operand = expr2tc();
-    }
-
-    new_expr_ref = expr2tc(new code_cpp_throw2t(operand, expr_list));
-  }
-  else if(expr.id() == "code" && expr.statement() == "throw-decl")
-  {
-    std::vector<irep_idt> expr_list;
-    const irept::subt &exceptions_thrown = expr.find("throw_list").get_sub();
-    for(const auto &e_it : exceptions_thrown)
-    {
-      expr_list.push_back(e_it.id());
-    }
 
-    new_expr_ref = expr2tc(new code_cpp_throw_decl2t(expr_list));
-  }
-  else if(expr.id() == "isinf")
+  case MIG_ISINF:
   {
     expr2tc theval;
     migrate_expr(expr.op0(), theval);
 
     isinf2t *n = new isinf2t(theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == "isnormal")
+
+  case MIG_ISNORMAL:
   {
     expr2tc theval;
     migrate_expr(expr.op0(), theval);
 
     isnormal2t *n = new isnormal2t(theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == "isfinite")
+
+  case MIG_ISFINITE:
   {
     expr2tc theval;
     migrate_expr(expr.op0(), theval);
 
     isfinite2t *n = new isfinite2t(theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == "signbit")
+
+  case MIG_SIGNBIT:
   {
     expr2tc theval;
     migrate_expr(expr.op0(), theval);
 
     signbit2t *n = new signbit2t(theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == "popcount")
+
+  case MIG_POPCOUNT:
   {
     expr2tc theval;
     migrate_expr(expr.op0(), theval);
 
     popcount2t *n = new popcount2t(theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == "bswap")
+
+  case MIG_BSWAP:
   {
     expr2tc theval;
     migrate_expr(expr.op0(), theval);
@@ -2055,15 +2571,19 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
 
     bswap2t *n = new bswap2t(type, theval);
     new_expr_ref = expr2tc(n);
+    break;
   }
-  else if(expr.id() == "concat")
+
+  case MIG_CONCAT:
   {
     expr2tc op0, op1;
     convert_operand_pair(expr, op0, op1);
     migrate_type(expr.type(), type);
     new_expr_ref = concat2tc(type, op0, op1);
+    break;
   }
-  else if(expr.id() == "extract")
+
+  case MIG_EXTRACT:
   {
     expr2tc theop;
     migrate_type(expr.type(), type);
@@ -2071,14 +2591,61 @@ void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
     unsigned int upper = atoi(expr.get("upper").as_string().c_str());
     unsigned int lower = atoi(expr.get("lower").as_string().c_str());
     new_expr_ref = extract2tc(type, theop, upper, lower);
+    break;
   }
-  else
+
+  default:
   {
-    expr.dump();
-    throw new std::string("migrate expr failed");
+    if(!has_prefix(expr.id_string(), "overflow-typecast-"))
+      migrate_expr_failed(expr);
+
+    unsigned bits = atoi(expr.id_string().c_str() + 18);
+    expr2tc operand;
+    migrate_expr(expr.op0(), operand);
+    new_expr_ref = expr2tc(new overflow_cast2t(operand, bits));
+    break;
+  }
   }
 }
 
+// Shared subtrees, such as the operands that goto_convert and goto_inline copy
+// about, are only migrated once per top level call to migrate_expr. Keys are
+// kept alive by the cache, so their addresses can't be reused while in there;
+// an unshared node can only be reached once and isn't worth recording.
+static std::unordered_map<const void *, std::pair<exprt, expr2tc>>
+  migrated_exprs;
+static unsigned int migrate_depth = 0;
+
+void migrate_expr(const exprt &expr, expr2tc &new_expr_ref)
+{
+  struct scopet
+  {
+    scopet()
+    {
+      migrate_depth++;
+    }
+    ~scopet()
+    {
+      if(--migrate_depth == 0 && !migrated_exprs.empty())
+        migrated_exprs.clear();
+    }
+  } scope;
+
+  if(!expr.is_shared())
+    return migrate_expr_node(expr, new_expr_ref);
+
+  auto it = migrated_exprs.find(expr.shared_data());
+  if(it != migrated_exprs.end())
+  {
+    new_expr_ref = it->second.second;
+    return;
+  }
+
+  migrate_expr_node(expr, new_expr_ref);
+  migrated_exprs.emplace(
+    expr.shared_data(), std::make_pair(expr, new_expr_ref));
+}
+
 typet migrate_type_back(const type2tc &ref)
 {
   switch(ref->type_id)
@@ -9,65 +9,77 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <util/irep_ids.h>
 #include <util/string_container.h>
 
 string_containert string_container [[gnu::init_priority(101)]];
 
-string_ptrt::string_ptrt(const char *_s) : s(_s), len(strlen(_s))
+string_containert::string_containert() : next_no(0)
 {
+  for(auto &seg : segments)
+    seg.store(nullptr, std::memory_order_relaxed);
+
+  // allocate empty string -- this gets index 0
+  get(string_ptrt(""));
+
+  // then the well known names, which irep_ids.h has numbered already
+  static const char *const well_known[] = {
+#define IREP_ID_STRING(id, str) str,
+    IREP_WELL_KNOWN_IDS(IREP_ID_STRING)
+#undef IREP_ID_STRING
+  };
+
+  for(const char *s : well_known)
+  {
+    unsigned no = get(string_ptrt(s));
+    assert(no == size() - 1 && "duplicate well known irep id");
+    (void)no;
+  }
+  assert(size() == ID_NO_last);
 }
 
-bool string_ptrt::operator==(const string_ptrt &other) const
+string_containert::~string_containert()
 {
-  if(len != other.len)
-    return false;
-
-  return len == 0 || memcmp(s, other.s, len) == 0;
+  for(auto &seg : segments)
+    delete[] seg.load(std::memory_order_relaxed);
 }
 
-unsigned string_containert::get(const char *s)
+std::string &string_containert::slot(size_t no)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-
-  if(it != hash_table.end())
-    return it->second;
-
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.emplace_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result] = r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  unsigned seg = segment_of(no);
+  assert(seg < num_segments && "string container is full");
+
+  std::string *strings = segments[seg].load(std::memory_order_acquire);
+  if(strings == nullptr)
+  {
+    std::lock_guard<std::mutex> guard(segment_lock);
+    strings = segments[seg].load(std::memory_order_relaxed);
+    if(strings == nullptr)
+    {
+      strings = new std::string[first_in(seg + 1) - first_in(seg)];
+      segments[seg].store(strings, std::memory_order_release);
+    }
+  }
+
+  return strings[no - first_in(seg)];
 }
 
-unsigned string_containert::get(const std::string &s)
+unsigned string_containert::get(const string_ptrt &s)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it = hash_table.find(string_ptr);
+  shardt &shard = shards[shard_of(s)];
+  std::lock_guard<std::mutex> guard(shard.lock);
 
-  if(it != hash_table.end())
+  hash_tablet::const_iterator it = shard.hash_table.find(s);
+  if(it != shard.hash_table.end())
     return it->second;
 
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result] = r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
+  // Store the string before it is numbered in the table: anyone who gets this
+  // number from here on can read the string without locking.
+  size_t r = next_no.fetch_add(1, std::memory_order_relaxed);
+  std::string &str = slot(r);
+  str.assign(s.s, s.len);
 
+  shard.hash_table.emplace(string_ptrt(str.c_str(), str.size()), r);
   return r;
 }
 
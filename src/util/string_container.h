@@ -9,86 +9,166 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef STRING_CONTAINER_H
 #define STRING_CONTAINER_H
 
+#include <atomic>
 #include <cassert>
-#include <list>
-#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <string>
-#include <vector>
+#include <unordered_map>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 struct string_ptrt
 {
   const char *s;
   size_t len;
+  uint64_t hash;
 
   const char *c_str() const
   {
     return s;
   }
 
-  explicit string_ptrt(const char *_s);
+  explicit string_ptrt(const char *_s) : string_ptrt(_s, strlen(_s))
+  {
+  }
+
+  explicit string_ptrt(const std::string &_s)
+    : string_ptrt(_s.c_str(), _s.size())
+  {
+  }
 
-  explicit string_ptrt(const std::string &_s) : s(_s.c_str()), len(_s.size())
+  string_ptrt(const char *_s, size_t _len)
+    : s(_s), len(_len), hash(hash_bytes(_s, _len))
   {
   }
 
-  bool operator==(const string_ptrt &other) const;
+  bool operator==(const string_ptrt &other) const
+  {
+    return hash == other.hash && len == other.len &&
+           (len == 0 || memcmp(s, other.s, len) == 0);
+  }
+
+  // FNV-1a, straight off the bytes: no temporary std::string to hash.
+  static uint64_t hash_bytes(const char *s, size_t len)
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for(size_t i = 0; i < len; i++)
+    {
+      h ^= (unsigned char)s[i];
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
 };
 
 class string_ptr_hash
 {
 public:
-  size_t operator()(const string_ptrt s) const
+  size_t operator()(const string_ptrt &s) const
   {
-    return std::hash<std::string>{}(s.s);
+    return s.hash;
   }
 };
 
+/** Interns strings, numbering each distinct one from zero (the empty string)
+ *  upwards, followed by the well known names of irep_ids.h.
+ *
+ *  Any thread may intern strings: the lookup tables are split into shards by
+ *  hash, each behind its own lock, so threads only contend when interning
+ *  strings that land in the same shard. Fetching the string for a number
+ *  takes no lock at all; strings live in segments that are never moved or
+ *  freed, and a number can only have been obtained after its string was
+ *  stored. */
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
-  string_containert()
-  {
-    // allocate empty string -- this gets index 0
-    get("");
-  }
-  ~string_containert() = default;
+  string_containert();
+  ~string_containert();
+
+  string_containert(const string_containert &) = delete;
+  string_containert &operator=(const string_containert &) = delete;
 
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    assert(no < string_vector.size());
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    assert(no < string_vector.size());
-    return *string_vector[no];
+    assert(no < size());
+    unsigned seg = segment_of(no);
+    return segments[seg].load(std::memory_order_acquire)[no - first_in(seg)];
+  }
+
+  size_t size() const
+  {
+    return next_no.load(std::memory_order_relaxed);
   }
 
 protected:
-  typedef std::unordered_map<string_ptrt, size_t, string_ptr_hash> hash_tablet;
-  hash_tablet hash_table;
+  unsigned get(const string_ptrt &s);
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  // Strings are stored in segments of doubling size, so that the n-th string
+  // is found with a couple of shifts and never has to move.
+  static constexpr unsigned first_segment_bits = 10;
+  static constexpr unsigned num_segments = 32 - first_segment_bits;
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  static unsigned segment_of(size_t no)
+  {
+    uint32_t biased = uint32_t(no >> first_segment_bits) + 1;
+#ifdef _MSC_VER
+    unsigned long msb;
+    _BitScanReverse(&msb, biased);
+    return msb;
+#else
+    return 31 - __builtin_clz(biased);
+#endif
+  }
+
+  static size_t first_in(unsigned seg)
+  {
+    return ((size_t(1) << seg) - 1) << first_segment_bits;
+  }
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  std::string &slot(size_t no);
+
+  std::atomic<std::string *> segments[num_segments];
+  std::mutex segment_lock;
+  std::atomic<size_t> next_no;
+
+  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
+    hash_tablet;
+
+  struct shardt
+  {
+    std::mutex lock;
+    hash_tablet hash_table;
+  };
+
+  static constexpr unsigned num_shards = 16;
+  shardt shards[num_shards];
+
+  static unsigned shard_of(const string_ptrt &s)
+  {
+    // The tables themselves bucket on the low bits.
+    return (s.hash >> 59) % num_shards;
+  }
 };
 
 extern string_containert string_container;
@@ -0,0 +1,64 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <solvers/smt/smt_cache.h>
+
+// The cache never looks into the ASTs it maps to, so stand-ins will do
+static int dummy_asts[3];
+static const smt_astt ast1 = reinterpret_cast<smt_astt>(&dummy_asts[0]);
+static const smt_astt ast2 = reinterpret_cast<smt_astt>(&dummy_asts[1]);
+static const smt_astt ast3 = reinterpret_cast<smt_astt>(&dummy_asts[2]);
+
+static expr2tc make_sum(const char *name)
+{
+  type2tc t = unsignedbv_type2tc(32);
+  return add2tc(t, symbol2tc(t, name), constant_int2tc(t, BigInt(1)));
+}
+
+TEST_CASE("smt_cachet finds by identity, then structure", "[unit][smt]")
+{
+  smt_cachet cache;
+  expr2tc a = make_sum("x");
+  cache.insert(a, ast1);
+
+  REQUIRE(cache.find(a) == ast1);
+  REQUIRE(cache.get_stats().identity_hits == 1);
+  REQUIRE(cache.get_stats().structural_hits == 0);
+
+  expr2tc same = make_sum("x");
+  REQUIRE(same.get() != a.get());
+  REQUIRE(cache.find(same) == ast1);
+  REQUIRE(cache.get_stats().identity_hits == 1);
+  REQUIRE(cache.get_stats().structural_hits == 1);
+
+  REQUIRE(cache.find(make_sum("y")) == nullptr);
+  REQUIRE(cache.get_stats().misses == 1);
+}
+
+TEST_CASE("smt_cachet pops back to the enclosing level", "[unit][smt]")
+{
+  smt_cachet cache;
+  expr2tc a = make_sum("x");
+  cache.insert(a, ast1);
+
+  cache.push_level();
+  expr2tc b = make_sum("y");
+  cache.insert(b, ast2);
+  REQUIRE(cache.find(b) == ast2);
+  REQUIRE(cache.size() == 2);
+
+  SECTION("an expr cached at an outer level keeps its AST")
+  {
+    cache.insert(make_sum("x"), ast3);
+    REQUIRE(cache.find(a) == ast1);
+    REQUIRE(cache.size() == 2);
+  }
+
+  cache.pop_level();
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.find(b) == nullptr);
+  REQUIRE(cache.find(make_sum("y")) == nullptr);
+  REQUIRE(cache.find(a) == ast1);
+  REQUIRE(cache.find(make_sum("x")) == ast1);
+  REQUIRE(cache.get_stats().peak_entries == 2);
+}
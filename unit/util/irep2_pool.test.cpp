@@ -0,0 +1,53 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <util/irep2_expr.h>
+#include <util/irep2_pool.h>
+
+static expr2tc make_sum(const type2tc &t)
+{
+  return add2tc(t, symbol2tc(t, "x"), constant_int2tc(t, BigInt(1)));
+}
+
+TEST_CASE("structurally equal exprs are interned once", "[unit][util][irep2]")
+{
+  irep2_poolt pool;
+  type2tc t = unsignedbv_type2tc(32);
+  expr2tc a = make_sum(t);
+  expr2tc b = make_sum(unsignedbv_type2tc(32));
+  REQUIRE(a.get() != b.get());
+
+  const expr2tc &ia = pool.intern(a);
+  const expr2tc &ib = pool.intern(b);
+  REQUIRE(ia.get() == ib.get());
+  REQUIRE(ia == a);
+
+  SECTION("operands and types are shared as well")
+  {
+    expr2tc other = sub2tc(t, symbol2tc(t, "x"), constant_int2tc(t, BigInt(1)));
+    const expr2tc &iother = pool.intern(other);
+    REQUIRE(to_add2t(ia).side_1.get() == to_sub2t(iother).side_1.get());
+    REQUIRE(ia->type.get() == iother->type.get());
+  }
+
+  SECTION("interning does not modify its argument")
+  {
+    REQUIRE(to_add2t(b).side_1.get() != to_add2t(ia).side_1.get());
+  }
+
+  SECTION("modifying an interned expr detaches it")
+  {
+    expr2tc copy = ia;
+    to_add2t(copy).side_2 = constant_int2tc(t, BigInt(2));
+    REQUIRE(copy.get() != ia.get());
+    REQUIRE(pool.intern(a).get() == ia.get());
+  }
+}
+
+TEST_CASE("nil exprs are not interned", "[unit][util][irep2]")
+{
+  irep2_poolt pool;
+  expr2tc nil;
+  REQUIRE(is_nil_expr(pool.intern(nil)));
+  REQUIRE(pool.size() == 0);
+}
@@ -0,0 +1,43 @@
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <util/irep.h>
+
+TEST_CASE("well known ids are numbered up front", "[unit][util][dstring]")
+{
+  REQUIRE(irep_idt("nil") == ID_nil);
+  REQUIRE(irep_idt("string-constant") == ID_string_constant);
+  REQUIRE(ID_struct.as_string() == "struct");
+  REQUIRE(irep_idt("").get_no() == 0);
+}
+
+TEST_CASE("strings interned concurrently agree", "[unit][util][dstring]")
+{
+  const unsigned nthreads = 8, nstrings = 5000;
+  std::vector<std::vector<unsigned>> nos(nthreads);
+
+  std::vector<std::thread> threads;
+  for(unsigned t = 0; t < nthreads; t++)
+    threads.emplace_back([t, &nos] {
+      // Every thread interns the same strings, in a different order
+      for(unsigned i = 0; i < nstrings; i++)
+      {
+        unsigned n = (i * 7919 + t * 613) % nstrings;
+        nos[t].push_back(irep_idt("concurrent$" + std::to_string(n)).get_no());
+      }
+    });
+  for(auto &th : threads)
+    th.join();
+
+  for(unsigned t = 0; t < nthreads; t++)
+    for(unsigned i = 0; i < nstrings; i++)
+    {
+      unsigned n = (i * 7919 + t * 613) % nstrings;
+      irep_idt id("concurrent$" + std::to_string(n));
+      REQUIRE(nos[t][i] == id.get_no());
+      REQUIRE(id.as_string() == "concurrent$" + std::to_string(n));
+    }
+}